@@ -1,7 +1,11 @@
 #include "benchmark.hpp"
 #include "algorithms.hpp"
 #include "generators.hpp"
+#include "parallel_sort.hpp"
+#include "heap.hpp"
+#include "perf_counters.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <csignal>
@@ -9,6 +13,10 @@
 #include <thread>
 #include <chrono>
 #include <fstream>
+#include <string>
+#include <stdexcept>
+#include <functional>
+#include <memory>
 
 
 // Обработчик Ctrl+C
@@ -18,10 +26,284 @@ void signal_handler(int signal) {
     std::exit(0);
 }
 
-int main() {
+// Аппаратные счетчики (ключ --counters), иначе nullptr
+coursework::PerfCounters* counters = nullptr;
+
+// Сумма счетчиков по замерам начинается с нулей, а не с -1
+const coursework::CounterValues zero_counters{0, 0, 0, 0, 0, 0};
+
+// Время сортировки копии data в микросекундах; при включенных счетчиках
+// их значения на участке прибавляются к *counted
+template<typename Sort>
+double time_sort(const std::vector<int>& data, Sort sort, coursework::CounterValues* counted = nullptr) {
+    std::vector<int> work = data;
+    if (counters && counted) counters->start();
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(work);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (counters && counted) *counted += counters->stop();
+    if (!std::is_sorted(work.begin(), work.end())) {
+        throw std::runtime_error("Sort failed");
+    }
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// Заголовок колонок счетчиков алгоритма name (средние на одну сортировку)
+std::string counter_columns(const std::string& name) {
+    std::string columns;
+    for (const char* counter : {"Cycles", "Instructions", "IPC", "L1DMisses", "LLCMisses", "BranchMisses", "DTLBMisses"}) {
+        columns += "," + name + counter;
+    }
+    return columns;
+}
+
+void write_counters(std::ofstream& file, const coursework::CounterValues& c) {
+    file << "," << c.cycles << "," << c.instructions << "," << c.ipc() << "," << c.l1d_misses
+         << "," << c.llc_misses << "," << c.branch_misses << "," << c.dtlb_misses;
+}
+
+// IPC и промахи на элемент
+void print_counters(const char* name, const coursework::CounterValues& c, size_t size) {
+    double n = static_cast<double>(size);
+    std::cout << "    " << name << ": IPC " << c.ipc()
+              << ", per element: L1D miss " << c.l1d_misses / n
+              << ", LLC miss " << c.llc_misses / n
+              << ", branch miss " << c.branch_misses / n
+              << ", dTLB miss " << c.dtlb_misses / n << "\n";
+}
+
+struct SweepEntry {
+    const char* name;
+    std::function<void(std::vector<int>&)> sort;
+};
+
+// Общий прогон: каждый алгоритм из entries на каждом размере, время и
+// ускорение относительно первого алгоритма, результаты в csv_name
+int run_sweep(const std::string& title, const std::string& csv_name,
+              const std::vector<size_t>& sizes, const std::vector<SweepEntry>& entries) {
+    std::cout << "=========================================\n";
+    std::cout << "  " << title << "\n";
+    std::cout << "=========================================\n\n";
+
+    coursework::ArrayGenerator generator;
+
+    std::ofstream file(csv_name);
+    file << "ArraySize";
+    for (const auto& entry : entries) file << "," << entry.name << "(us)";
+    file << ",Iterations";
+    if (counters) {
+        for (const auto& entry : entries) file << counter_columns(entry.name);
+    }
+    file << "\n";
+
+    for (size_t size : sizes) {
+        size_t iterations = size <= 100000 ? 20 : (size <= 1000000 ? 5 : 1);
+        std::vector<double> totals(entries.size(), 0.0);
+        std::vector<coursework::CounterValues> counted(entries.size(), zero_counters);
+
+        try {
+            for (size_t i = 0; i < iterations; ++i) {
+                auto data = generator.generate(size, coursework::DataType::RANDOM);
+                for (size_t k = 0; k < entries.size(); ++k) {
+                    totals[k] += time_sort(data, entries[k].sort, &counted[k]);
+                }
+            }
+        } catch (const std::bad_alloc&) {
+            std::cerr << "Size " << size << ": out of memory, sweep stopped\n";
+            break;
+        }
+
+        std::cout << "Size " << size << ":";
+        file << size;
+        for (size_t k = 0; k < entries.size(); ++k) {
+            double t = totals[k] / iterations;
+            std::cout << " " << entries[k].name << " " << t << " us";
+            if (k > 0) std::cout << " (" << (totals[0] / totals[k]) << "x)";
+            std::cout << (k + 1 < entries.size() ? "," : "\n") << std::flush;
+            file << "," << t;
+        }
+        file << "," << iterations;
+        if (counters) {
+            for (size_t k = 0; k < entries.size(); ++k) {
+                auto average = counted[k].scaled(1.0 / iterations);
+                print_counters(entries[k].name, average, size);
+                write_counters(file, average);
+            }
+        }
+        file << "\n";
+        file.flush();
+    }
+
+    std::cout << "\n[SUCCESS] Results saved to: " << csv_name << "\n";
+    return 0;
+}
+
+// Сравнение бинарной и d-арных куч (4/8) на размерах 10k..100M
+int run_arity_sweep() {
+    return run_sweep("ARITY SWEEP: heap_sort<2/4/8>", "arity_sweep_results.csv",
+                     {10000, 100000, 1000000, 10000000, 100000000},
+                     {{"Binary", [](std::vector<int>& v) { coursework::heap_sort(v.begin(), v.end()); }},
+                      {"Arity4", [](std::vector<int>& v) { coursework::heap_sort<4>(v.begin(), v.end()); }},
+                      {"Arity8", [](std::vector<int>& v) { coursework::heap_sort<8>(v.begin(), v.end()); }}});
+}
+
+// heap_sort против prefetch_heap_sort на массивах вне кэша (10M..1B)
+int run_prefetch_sweep() {
+    return run_sweep("PREFETCH: heap_sort vs prefetch_heap_sort", "prefetch_results.csv",
+                     {10000000, 100000000, 1000000000},
+                     {{"HeapSort", [](std::vector<int>& v) { coursework::heap_sort(v.begin(), v.end()); }},
+                      {"PrefetchHeapSort", [](std::vector<int>& v) { coursework::prefetch_heap_sort(v.begin(), v.end()); }}});
+}
+
+// Сильная масштабируемость parallel_sort: один и тот же массив на 1, 2, 4, ...
+// потоках до числа ядер, ускорение относительно одного потока (1M..1B)
+int run_scaling_sweep() {
+    std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    std::vector<std::unique_ptr<coursework::ThreadPool>> pools;
+    std::vector<std::string> names;
+    for (std::size_t t : thread_counts) {
+        pools.push_back(std::make_unique<coursework::ThreadPool>(t));
+        names.push_back("Threads" + std::to_string(t));
+    }
+
+    std::vector<SweepEntry> entries;
+    for (std::size_t k = 0; k < pools.size(); ++k) {
+        coursework::ThreadPool* pool = pools[k].get();
+        entries.push_back({names[k].c_str(), [pool](std::vector<int>& v) {
+            coursework::parallel_sort(*pool, v.begin(), v.end());
+        }});
+    }
+    return run_sweep("STRONG SCALING: parallel_sort, 1.." + std::to_string(max_threads) + " threads",
+                     "scaling_results.csv", {1000000, 10000000, 100000000, 1000000000}, entries);
+}
+
+// Top-k для n = 10^6..10^9 и k = 10..10^5. TopK получает вход фрагментами
+// по 2^20 элементов (память O(k), время генерации не учитывается);
+// partial_heap_sort и std::partial_sort - на массиве в памяти до 10^8,
+// полный heap_sort для сравнения - до 10^7.
+int run_topk_sweep() {
+    std::cout << "=========================================\n";
+    std::cout << "  TOP-K: TopK stream vs partial_heap_sort\n";
+    std::cout << "=========================================\n\n";
+
+    const size_t chunk_size = size_t(1) << 20;
+    const size_t max_in_memory = 100000000;
+    const size_t max_full_sort = 10000000;
+    const int distinct = 1000000000;
+    coursework::ArrayGenerator generator;
+
+    std::ofstream file("topk_results.csv");
+    file << "N,K,TopKStream(us),PartialHeapSort(us),StdPartialSort(us),HeapSort(us)\n";
+
+    for (size_t n : {size_t(1000000), size_t(10000000), size_t(100000000), size_t(1000000000)}) {
+        std::vector<int> data;
+        try {
+            if (n <= max_in_memory) data = generator.generate_few_unique(n, distinct);
+        } catch (const std::bad_alloc&) {
+            std::cerr << "N " << n << ": out of memory, in-memory sorts skipped\n";
+        }
+
+        double heap_sort_time = -1.0;
+        if (!data.empty() && n <= max_full_sort) {
+            heap_sort_time = time_sort(data, [](std::vector<int>& v) { coursework::heap_sort(v.begin(), v.end()); });
+        }
+
+        for (size_t k : {size_t(10), size_t(1000), size_t(100000)}) {
+            double stream_time = 0.0;
+            coursework::TopK<int> top(k);
+            for (size_t done = 0; done < n; done += chunk_size) {
+                std::vector<int> chunk = data.empty()
+                    ? generator.generate_few_unique(std::min(chunk_size, n - done), distinct)
+                    : std::vector<int>(data.begin() + done, data.begin() + std::min(n, done + chunk_size));
+                auto start = std::chrono::high_resolution_clock::now();
+                top.consume(chunk.begin(), chunk.end());
+                auto end = std::chrono::high_resolution_clock::now();
+                stream_time += std::chrono::duration<double, std::micro>(end - start).count();
+            }
+            std::vector<int> best = top.sorted();
+
+            double partial_time = -1.0, std_partial_time = -1.0;
+            if (!data.empty()) {
+                std::vector<int> work = data;
+                auto start = std::chrono::high_resolution_clock::now();
+                coursework::partial_heap_sort(work.begin(), work.begin() + k, work.end());
+                auto end = std::chrono::high_resolution_clock::now();
+                partial_time = std::chrono::duration<double, std::micro>(end - start).count();
+                if (!std::equal(best.begin(), best.end(), work.begin())) {
+                    throw std::runtime_error("TopK and partial_heap_sort disagree");
+                }
+
+                work = data;
+                start = std::chrono::high_resolution_clock::now();
+                std::partial_sort(work.begin(), work.begin() + k, work.end());
+                end = std::chrono::high_resolution_clock::now();
+                std_partial_time = std::chrono::duration<double, std::micro>(end - start).count();
+            }
+
+            std::cout << "N " << n << ", k " << k << ": TopK " << stream_time << " us";
+            if (partial_time >= 0) {
+                std::cout << ", partial_heap_sort " << partial_time << " us"
+                          << ", std::partial_sort " << std_partial_time << " us";
+            }
+            if (heap_sort_time >= 0) std::cout << ", heap_sort " << heap_sort_time << " us";
+            std::cout << "\n" << std::flush;
+
+            file << n << "," << k << "," << stream_time << "," << partial_time << ","
+                 << std_partial_time << "," << heap_sort_time << "\n";
+            file.flush();
+        }
+    }
+
+    std::cout << "\n[SUCCESS] Results saved to: topk_results.csv\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     std::signal(SIGINT, signal_handler);
     
     try {
+        // --counters в любом месте: аппаратные счетчики на каждом замере
+        // (кроме --topk); недоступны - замеры идут без них
+        std::string mode;
+        bool use_counters = false;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--counters") use_counters = true;
+            else if (mode.empty()) mode = arg;
+        }
+        std::unique_ptr<coursework::PerfCounters> perf;
+        if (use_counters) {
+            perf = std::make_unique<coursework::PerfCounters>();
+            if (perf->available()) {
+                counters = perf.get();
+                std::cout << "Hardware counters: " << perf->status() << "\n\n";
+            } else {
+                std::cout << "Hardware counters unavailable (" << perf->status() << "), timing only\n\n";
+            }
+        }
+
+        // benchmark_large --arity-sweep: только сравнение арности кучи
+        if (mode == "--arity-sweep") {
+            return run_arity_sweep();
+        }
+        // benchmark_large --prefetch: heap_sort против prefetch_heap_sort
+        if (mode == "--prefetch") {
+            return run_prefetch_sweep();
+        }
+        // benchmark_large --scaling: parallel_sort на 1..N потоках
+        if (mode == "--scaling") {
+            return run_scaling_sweep();
+        }
+        // benchmark_large --topk: потоковый top-k и partial_heap_sort
+        if (mode == "--topk") {
+            return run_topk_sweep();
+        }
+
+
         //coursework::Benchmark benchmark;
         
         std::cout << "=========================================\n";
@@ -77,6 +359,8 @@ int main() {
             
             double total_heap = 0.0;
             double total_std = 0.0;
+            coursework::CounterValues heap_counters = zero_counters;
+            coursework::CounterValues std_counters = zero_counters;
             
             coursework::ArrayGenerator generator;
             
@@ -93,15 +377,19 @@ int main() {
                 auto data = generator.generate(size, coursework::DataType::RANDOM);
                 
                 // Heap Sort
+                if (counters) counters->start();
                 auto start = std::chrono::high_resolution_clock::now();
                 coursework::heap_sort(data.begin(), data.end());
                 auto end = std::chrono::high_resolution_clock::now();
+                if (counters) heap_counters += counters->stop();
                 total_heap += std::chrono::duration<double, std::micro>(end - start).count();
                 
                 // std::sort (на уже отсортированных данных)
+                if (counters) counters->start();
                 start = std::chrono::high_resolution_clock::now();
                 std::sort(data.begin(), data.end());
                 end = std::chrono::high_resolution_clock::now();
+                if (counters) std_counters += counters->stop();
                 total_std += std::chrono::duration<double, std::micro>(end - start).count();
             }
             
@@ -109,6 +397,12 @@ int main() {
             
             result.heap_sort_time = total_heap / iterations;
             result.std_sort_time = total_std / iterations;
+            if (counters) {
+                result.counters_available = true;
+                result.counters_status = counters->status();
+                result.timings.push_back({"Heap Sort", {}, heap_counters.scaled(1.0 / iterations)});
+                result.timings.push_back({"std::sort", {}, std_counters.scaled(1.0 / iterations)});
+            }
             results.push_back(result);
             
             // Промежуточный вывод
@@ -122,6 +416,9 @@ int main() {
             }
             
             std::cout << "  std::sort: " << result.std_sort_time << " μs\n";
+            for (const auto& timing : result.timings) {
+                print_counters(timing.algorithm.c_str(), timing.counters, size);
+            }
             
             double ratio = result.heap_sort_time / result.std_sort_time;
             std::cout << "  Ratio (Heap/std): " << ratio << "x (";
@@ -135,12 +432,16 @@ int main() {
         // Сохранение результатов
         std::ofstream file("large_scale_results.csv");
         if (file.is_open()) {
-            file << "ArraySize,HeapSortMicroseconds,StdSortMicroseconds,Iterations\n";
+            file << "ArraySize,HeapSortMicroseconds,StdSortMicroseconds,Iterations";
+            if (counters) file << counter_columns("HeapSort") << counter_columns("StdSort");
+            file << "\n";
             for (const auto& res : results) {
                 file << res.array_size << ","
                      << res.heap_sort_time << ","
                      << res.std_sort_time << ","
-                     << res.iterations << "\n";
+                     << res.iterations;
+                for (const auto& timing : res.timings) write_counters(file, timing.counters);
+                file << "\n";
             }
             file.close();
             std::cout << "\n[SUCCESS] Results saved to: large_scale_results.csv\n";
@@ -168,4 +469,4 @@ int main() {
         //std::cerr << "\n[ERROR] " << e.what() << "\n";
         return 1;
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "external_sort.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// external_sort - сортировка двоичного файла int32 больше оперативной памяти
+//
+//   external_sort <input> <output> [--memory MB] [--buffer MB] [--temp DIR]
+//   external_sort --generate <file> <count>
+//   external_sort --benchmark <count> [--memory MB] [--buffer MB] [--temp DIR]
+//
+// --benchmark создает файл из count случайных чисел во временном каталоге,
+// сортирует его, проверяет результат и печатает пропускную способность.
+
+namespace {
+
+void print_usage() {
+    std::cout << "Usage:\n"
+              << "  external_sort <input> <output> [--memory MB] [--buffer MB] [--temp DIR]\n"
+              << "  external_sort --generate <file> <count>\n"
+              << "  external_sort --benchmark <count> [--memory MB] [--buffer MB] [--temp DIR]\n";
+}
+
+double megabytes(double bytes) { return bytes / (1024.0 * 1024.0); }
+
+// Пропускная способность "X MB/s"; "-" для нулевого времени (пустой или
+// крошечный вход, слияние без проходов)
+std::string throughput(double mb, double seconds) {
+    if (seconds <= 0) return "-";
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2) << mb / seconds << " MB/s";
+    return ss.str();
+}
+
+void print_stats(const coursework::ExternalSortStats& stats, const coursework::ExternalSortOptions& options) {
+    double total = stats.run_generation_seconds + stats.merge_seconds;
+    double mb = megabytes(static_cast<double>(stats.bytes));
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Elements:        " << stats.elements << " (" << mb << " MB)\n";
+    std::cout << "Memory budget:   " << megabytes(static_cast<double>(options.memory_budget)) << " MB, "
+              << "I/O buffer " << megabytes(static_cast<double>(options.io_buffer_size)) << " MB, "
+              << "fan-in " << stats.fan_in << "\n";
+    std::cout << "Runs:            " << stats.runs;
+    if (stats.runs > 0) {
+        double average = static_cast<double>(stats.elements) / stats.runs;
+        std::cout << " (average " << megabytes(average * sizeof(int)) << " MB = "
+                  << average / static_cast<double>(stats.heap_elements) << "x selection heap)";
+    }
+    std::cout << "\n";
+    std::cout << "Run generation:  " << stats.run_generation_seconds << " s, "
+              << throughput(mb, stats.run_generation_seconds) << "\n";
+    std::cout << "Merge:           " << stats.merge_seconds << " s, " << stats.merge_passes << " pass(es), "
+              << throughput(mb * stats.merge_passes, stats.merge_seconds) << " per pass\n";
+    std::cout << "Total:           " << total << " s, " << throughput(mb, total) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) {
+            print_usage();
+            return 1;
+        }
+        std::string first = argv[1];
+
+        if (first == "--generate") {
+            if (argc != 4) {
+                print_usage();
+                return 1;
+            }
+            coursework::write_random_file(argv[2], std::stoull(argv[3]));
+            return 0;
+        }
+
+        // Оба режима - два позиционных аргумента, дальше ключи
+        coursework::ExternalSortOptions options;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                print_usage();
+                return 1;
+            }
+            if (arg == "--memory") options.memory_budget = std::stoull(argv[++i]) << 20;
+            else if (arg == "--buffer") options.io_buffer_size = std::stoull(argv[++i]) << 20;
+            else if (arg == "--temp") options.temp_dir = argv[++i];
+            else {
+                print_usage();
+                return 1;
+            }
+        }
+
+        if (first == "--benchmark") {
+            std::filesystem::path dir = options.temp_dir.empty()
+                ? std::filesystem::temp_directory_path() : std::filesystem::path(options.temp_dir);
+            std::string input = (dir / "external_sort_input.bin").string();
+            std::string output = (dir / "external_sort_output.bin").string();
+
+            std::uint64_t count = std::stoull(argv[2]);
+            std::cout << "Generating " << count << " random int32...\n";
+            coursework::write_random_file(input, count);
+
+            auto stats = coursework::external_sort(input, output, options);
+            print_stats(stats, options);
+            bool sorted = coursework::is_sorted_file(output);
+            std::cout << "Output sorted:   " << (sorted ? "yes" : "NO") << "\n";
+
+            std::filesystem::remove(input);
+            std::filesystem::remove(output);
+            return sorted ? 0 : 1;
+        }
+
+        auto stats = coursework::external_sort(argv[1], argv[2], options);
+        print_stats(stats, options);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
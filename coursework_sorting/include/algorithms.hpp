@@ -1,58 +1,1067 @@
-#pragma once
-#include <vector>
-#include <iterator>
-#include <algorithm>
-
-namespace coursework {
-
-// Insertion Sort
-template<typename Iter>
-void insertion_sort(Iter begin, Iter end) {
-    if (begin == end) return;
-    for (Iter i = begin + 1; i != end; ++i) {
-        auto key = *i;
-        Iter j = i;
-        while (j != begin && *(j - 1) > key) {
-            *j = *(j - 1);
-            --j;
-        }
-        *j = key;
-    }
-}
-
-// Вспомогательная функция для Heap Sort
-template<typename Iter>
-void heapify(Iter begin, Iter end, int n, int i) {
-    int largest = i;
-    int left = 2 * i + 1;
-    int right = 2 * i + 2;
-
-    if (left < n && *(begin + left) > *(begin + largest))
-        largest = left;
-    if (right < n && *(begin + right) > *(begin + largest))
-        largest = right;
-
-    if (largest != i) {
-        std::swap(*(begin + i), *(begin + largest));
-        heapify(begin, end, n, largest);
-    }
-}
-
-// Heap Sort
-template<typename Iter>
-void heap_sort(Iter begin, Iter end) {
-    auto n = std::distance(begin, end);
-    if (n <= 1) return;
-
-    // Построение кучи
-    for (int i = n / 2 - 1; i >= 0; i--)
-        heapify(begin, end, n, i);
-
-    // Извлечение элементов из кучи
-    for (int i = n - 1; i > 0; i--) {
-        std::swap(*begin, *(begin + i));
-        heapify(begin, end, i, 0);
-    }
-}
-
-} // namespace coursework
\ No newline at end of file
+#pragma once
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include <cstring>
+#include <functional>
+#include <cstdint>
+#include "simd_kernels.hpp"
+#include "simd_sort.hpp"
+#include "sorting_networks.hpp"
+
+namespace coursework {
+
+// Тождественная проекция (аналог std::identity из C++20)
+struct identity {
+    template<typename T>
+    constexpr T&& operator()(T&& t) const noexcept { return std::forward<T>(t); }
+};
+
+namespace detail {
+
+// Сравнение элементов с учетом проекции: less(a, b) == comp(proj(a), proj(b)).
+// Все алгоритмы ниже работают только через него, поэтому по умолчанию
+// (std::less<>, identity) после инлайнинга остается обычный operator<.
+template<typename Compare, typename Proj>
+struct projected_less {
+    Compare comp;
+    Proj proj;
+
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) {
+        return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+    }
+};
+
+template<typename Compare, typename Proj>
+projected_less<Compare, Proj> make_less(Compare comp, Proj proj) {
+    return {std::move(comp), std::move(proj)};
+}
+
+} // namespace detail
+
+// Insertion Sort (элементы только перемещаются, поэтому подходят
+// тяжелые типы вроде std::string и move-only типы вроде std::unique_ptr).
+// comp задает порядок (по умолчанию по возрастанию), proj - ключ элемента.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void insertion_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    if (begin == end) return;
+    for (Iter i = begin + 1; i != end; ++i) {
+        auto key = std::move(*i);
+        Iter j = i;
+        while (j != begin && less(key, *(j - 1))) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(key);
+    }
+}
+
+namespace detail {
+
+// Итераторы, за которыми лежит непрерывный массив (указатель или vector<T>)
+template<typename Iter, typename T = typename std::iterator_traits<Iter>::value_type>
+struct is_contiguous_iter : std::integral_constant<bool,
+    std::is_pointer<Iter>::value ||
+    (!std::is_same<T, bool>::value &&
+     std::is_same<Iter, typename std::vector<T>::iterator>::value)> {};
+
+// Сдвиг [first, last) на одну позицию вправо: memmove для тривиально
+// копируемых типов в непрерывной памяти, иначе поэлементно
+template<typename Iter>
+void shift_right_by_one(Iter first, Iter last, std::true_type) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    T* p = &*first;
+    std::memmove(p + 1, p, static_cast<std::size_t>(last - first) * sizeof(T));
+}
+
+template<typename Iter>
+void shift_right_by_one(Iter first, Iter last, std::false_type) {
+    std::move_backward(first, last, last + 1);
+}
+
+} // namespace detail
+
+// Binary Insertion Sort: позиция ищется бинарным поиском, блок сдвигается
+// одним memmove. Первые несколько шагов - линейный просмотр, поэтому на
+// почти отсортированных данных поведение как у insertion_sort.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void binary_insertion_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    using T = typename std::iterator_traits<Iter>::value_type;
+    using Contiguous = std::integral_constant<bool,
+        detail::is_contiguous_iter<Iter>::value && std::is_trivially_copyable<T>::value>;
+    const int linear_steps = 8;
+
+    if (begin == end) return;
+    for (Iter i = begin + 1; i != end; ++i) {
+        if (!less(*i, *(i - 1))) continue;
+
+        T key = std::move(*i);
+        Iter j = i;
+        int steps = 0;
+        while (j != begin && steps < linear_steps && less(key, *(j - 1))) {
+            *j = std::move(*(j - 1));
+            --j;
+            ++steps;
+        }
+        if (j != begin && steps == linear_steps && less(key, *(j - 1))) {
+            // Первый элемент больше key (стабильно: равные остаются левее)
+            Iter pos = std::upper_bound(begin, j, key, less);
+            detail::shift_right_by_one(pos, j, Contiguous{});
+            j = pos;
+        }
+        *j = std::move(key);
+    }
+}
+
+namespace detail {
+
+// Обычный порядок по возрастанию: std::less без проекции, в том числе
+// уже обернутый в projected_less (так small_sort вызывается из hybrid_sort)
+template<typename Less, typename T>
+struct is_plain_less : std::integral_constant<bool,
+    std::is_same<Less, std::less<>>::value || std::is_same<Less, std::less<T>>::value> {};
+
+template<typename Compare, typename T>
+struct is_plain_less<projected_less<Compare, identity>, T> : is_plain_less<Compare, T> {};
+
+// Естественный порядок (по возрастанию или убыванию): равные по нему
+// элементы арифметического типа совпадают, и перестановка их не видна
+template<typename Less, typename T>
+struct is_natural_order : std::integral_constant<bool,
+    is_plain_less<Less, T>::value ||
+    std::is_same<Less, std::greater<>>::value || std::is_same<Less, std::greater<T>>::value> {};
+
+template<typename Compare, typename T>
+struct is_natural_order<projected_less<Compare, identity>, T> : is_natural_order<Compare, T> {};
+
+// Блок можно отдать векторным ядрам simd::sort_block: int/float подряд в памяти
+template<typename Iter, typename Less>
+struct use_simd_block : std::integral_constant<bool,
+    is_contiguous_iter<Iter>::value &&
+    (std::is_same<typename std::iterator_traits<Iter>::value_type, int>::value ||
+     std::is_same<typename std::iterator_traits<Iter>::value_type, float>::value) &&
+    is_plain_less<Less, typename std::iterator_traits<Iter>::value_type>::value> {};
+
+// Ниже этого размера сеть компараторов не медленнее векторного блока
+constexpr std::size_t simd_block_min_size = 16;
+
+} // namespace detail
+
+// Small Sort: int/float по возрастанию от 17 до 64 элементов сортируются
+// в регистрах (simd::sort_block, если процессор поддерживает AVX2/AVX-512);
+// (векторные ядра ставят -0.0 перед +0.0); для арифметических типов без
+// проекции в порядке std::less/std::greater до 32 элементов - сетью
+// компараторов без ветвлений (равные элементы тогда неразличимы, кроме -0.0
+// и +0.0, которые сеть может переставить между собой), иначе - устойчивой
+// insertion_sort. Все пути переставляют элементы, не меняя их набор.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void small_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    auto n = static_cast<std::size_t>(std::distance(begin, end));
+    if constexpr (detail::use_simd_block<Iter, detail::projected_less<Compare, Proj>>::value) {
+        if (n > detail::simd_block_min_size && n <= simd::max_block_size &&
+            simd::active_isa() != simd::Isa::SCALAR) {
+            simd::sort_block(&*begin, n);
+            return;
+        }
+    }
+    if constexpr (std::is_arithmetic<T>::value && std::is_same<Proj, identity>::value &&
+                  detail::is_natural_order<Compare, T>::value) {
+        if (n <= detail::max_network_size) {
+            auto less = detail::make_less(std::move(comp), std::move(proj));
+            sort_with_network(begin, n, less);
+            return;
+        }
+    }
+    insertion_sort(begin, end, std::move(comp), std::move(proj));
+}
+
+namespace detail {
+
+// Просеивание вниз методом "дырки": вытесняемый элемент хранится в value
+// и записывается один раз, дети перемещаются (std::move) на место дырки.
+// Индексы имеют тип difference_type, поэтому массивы > 2^31 поддерживаются.
+template<typename Iter, typename Distance, typename T, typename Less>
+void sift_down(Iter begin, Distance n, Distance hole, T value, Less& less) {
+    for (;;) {
+        Distance child = 2 * hole + 1;
+        if (child >= n) break;
+        if (child + 1 < n && less(*(begin + child), *(begin + (child + 1))))
+            ++child;
+        if (!less(value, *(begin + child))) break;
+        *(begin + hole) = std::move(*(begin + child));
+        hole = child;
+    }
+    *(begin + hole) = std::move(value);
+}
+
+// Просеивание снизу вверх (Wegener/Floyd): дырка спускается до листа по
+// большему ребенку (одно сравнение на уровень), затем value поднимается
+// вверх до своего места. Ключ обычно оседает у листа, поэтому подъем короткий.
+template<typename Iter, typename Distance, typename T, typename Less>
+void sift_down_bottom_up(Iter begin, Distance n, Distance hole, T value, Less& less) {
+    const Distance top = hole;
+    for (;;) {
+        Distance child = 2 * hole + 1;
+        if (child >= n) break;
+        if (child + 1 < n && less(*(begin + child), *(begin + (child + 1))))
+            ++child;
+        *(begin + hole) = std::move(*(begin + child));
+        hole = child;
+    }
+    while (hole > top) {
+        Distance parent = (hole - 1) / 2;
+        if (!less(*(begin + parent), value)) break;
+        *(begin + hole) = std::move(*(begin + parent));
+        hole = parent;
+    }
+    *(begin + hole) = std::move(value);
+}
+
+// SIMD ядро применимо к int в непрерывной памяти при порядке по умолчанию
+template<typename Iter, typename Less>
+struct use_simd_int : std::integral_constant<bool,
+    is_contiguous_iter<Iter>::value &&
+    std::is_same<typename std::iterator_traits<Iter>::value_type, int>::value &&
+    (std::is_same<Less, projected_less<std::less<>, identity>>::value ||
+     std::is_same<Less, projected_less<std::less<int>, identity>>::value)> {};
+
+// Наибольший из Arity детей, лежащих подряд начиная с first
+template<std::size_t Arity, typename Iter, typename Less>
+std::size_t max_child(Iter first, Less& less, std::false_type) {
+    std::size_t best = 0;
+    for (std::size_t k = 1; k < Arity; ++k)
+        if (less(*(first + best), *(first + k))) best = k;
+    return best;
+}
+
+// Для int в непрерывной памяти - SIMD ядро (4/8 детей за одну загрузку)
+template<std::size_t Arity, typename Iter, typename Less>
+std::size_t max_child(Iter first, Less&, std::true_type) {
+    return simd::max_index<Arity>(&*first);
+}
+
+// Наблюдатель перемещений в куче: lifted(hole) - value взят из позиции
+// hole, moved(to, from) - элемент переехал из from в to, placed(to) - value
+// записан в to. Heap по нему обновляет позиции handle'ов; по умолчанию
+// пустой и исчезает при инлайнинге.
+struct no_heap_moves {
+    template<typename Distance> void lifted(Distance) const noexcept {}
+    template<typename Distance> void moved(Distance, Distance) const noexcept {}
+    template<typename Distance> void placed(Distance) const noexcept {}
+};
+
+// Просеивание вниз в d-арной куче: дети узла i лежат подряд
+// в [Arity*i + 1, Arity*i + Arity], т.е. в одной-двух кэш-линиях.
+// При Prefetch заранее запрашиваются внуки (Arity^2 элементов подряд),
+// чтобы промах следующего уровня перекрывался с работой на текущем.
+template<std::size_t Arity, bool Prefetch = false, typename Iter, typename Distance, typename T, typename Less,
+         typename Moves = no_heap_moves>
+void sift_down_dary(Iter begin, Distance n, Distance hole, T value, Less& less, Moves moves = {}) {
+    const Distance arity = static_cast<Distance>(Arity);
+    moves.lifted(hole);
+    for (;;) {
+        Distance first = arity * hole + 1;
+        if (first >= n) break;
+        if (Prefetch) {
+            Distance grand_first = arity * first + 1;
+            Distance grand_last = grand_first + arity * arity - 1;
+            if (grand_last < n) {
+                simd::prefetch(&*(begin + grand_first));
+                simd::prefetch(&*(begin + grand_last));
+            } else if (grand_first < n) {
+                simd::prefetch(&*(begin + grand_first));
+            }
+        }
+        Distance child = first;
+        if (n - first >= arity) {
+            child += static_cast<Distance>(
+                max_child<Arity>(begin + first, less, use_simd_int<Iter, Less>{}));
+        } else {
+            for (Distance c = first + 1; c < n; ++c)
+                if (less(*(begin + child), *(begin + c))) child = c;
+        }
+        if (!less(value, *(begin + child))) break;
+        *(begin + hole) = std::move(*(begin + child));
+        moves.moved(hole, child);
+        hole = child;
+    }
+    *(begin + hole) = std::move(value);
+    moves.placed(hole);
+}
+
+// Просеивание снизу вверх в d-арной куче: дырка спускается до листа по
+// наибольшему ребенку, затем value поднимается (см. sift_down_bottom_up).
+// Выгодно, когда value заведомо мал - например, последний элемент кучи.
+template<std::size_t Arity, typename Iter, typename Distance, typename T, typename Less,
+         typename Moves = no_heap_moves>
+void sift_down_bottom_up_dary(Iter begin, Distance n, Distance hole, T value, Less& less, Moves moves = {}) {
+    const Distance arity = static_cast<Distance>(Arity);
+    const Distance top = hole;
+    moves.lifted(hole);
+    for (;;) {
+        Distance first = arity * hole + 1;
+        if (first >= n) break;
+        Distance child = first;
+        if (n - first >= arity) {
+            child += static_cast<Distance>(
+                max_child<Arity>(begin + first, less, use_simd_int<Iter, Less>{}));
+        } else {
+            for (Distance c = first + 1; c < n; ++c)
+                if (less(*(begin + child), *(begin + c))) child = c;
+        }
+        *(begin + hole) = std::move(*(begin + child));
+        moves.moved(hole, child);
+        hole = child;
+    }
+    while (hole > top) {
+        Distance parent = (hole - 1) / arity;
+        if (!less(*(begin + parent), value)) break;
+        *(begin + hole) = std::move(*(begin + parent));
+        moves.moved(hole, parent);
+        hole = parent;
+    }
+    *(begin + hole) = std::move(value);
+    moves.placed(hole);
+}
+
+// Просеивание вверх в d-арной куче (вставка, повышение приоритета)
+template<std::size_t Arity, typename Iter, typename Distance, typename T, typename Less,
+         typename Moves = no_heap_moves>
+void sift_up_dary(Iter begin, Distance hole, T value, Less& less, Moves moves = {}) {
+    const Distance arity = static_cast<Distance>(Arity);
+    moves.lifted(hole);
+    while (hole > 0) {
+        Distance parent = (hole - 1) / arity;
+        if (!less(*(begin + parent), value)) break;
+        *(begin + hole) = std::move(*(begin + parent));
+        moves.moved(hole, parent);
+        hole = parent;
+    }
+    *(begin + hole) = std::move(value);
+    moves.placed(hole);
+}
+
+// Построение d-арной кучи за O(n): просеивание от последнего внутреннего
+// узла (родителя элемента n - 1) к корню
+template<std::size_t Arity, bool Prefetch = false, typename Iter, typename Less, typename Moves = no_heap_moves>
+void build_heap_dary(Iter begin, Iter end, Less& less, Moves moves = {}) {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance n = std::distance(begin, end);
+    if (n <= 1) return;
+    for (Distance i = (n - 2) / static_cast<Distance>(Arity) + 1; i-- > 0; )
+        sift_down_dary<Arity, Prefetch>(begin, n, i, std::move(*(begin + i)), less, moves);
+}
+
+template<std::size_t Arity, bool Prefetch, typename Iter, typename Less>
+void dary_heap_sort(Iter begin, Iter end, Less less) {
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance n = std::distance(begin, end);
+    if (n <= 1) return;
+
+    build_heap_dary<Arity, Prefetch>(begin, end, less);
+
+    for (Distance i = n - 1; i > 0; --i) {
+        auto value = std::move(*(begin + i));
+        *(begin + i) = std::move(*begin);
+        sift_down_dary<Arity, Prefetch>(begin, i, Distance(0), std::move(value), less);
+    }
+}
+
+} // namespace detail
+
+// Вспомогательная функция для Heap Sort (итеративная, без рекурсии)
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void heapify(Iter begin, Iter end,
+             typename std::iterator_traits<Iter>::difference_type n,
+             typename std::iterator_traits<Iter>::difference_type i,
+             Compare comp = {}, Proj proj = {}) {
+    (void)end;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    detail::sift_down(begin, n, i, std::move(*(begin + i)), less);
+}
+
+// Построение двоичной max-кучи на [begin, end) (аналог std::make_heap)
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void build_heap(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance n = std::distance(begin, end);
+    for (Distance i = n / 2; i-- > 0; )
+        detail::sift_down(begin, n, i, std::move(*(begin + i)), less);
+}
+
+// Извлечение элементов из кучи (аналог std::sort_heap): максимум уходит
+// в конец, последний элемент просеивается от корня
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void extract_heap(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance n = std::distance(begin, end);
+    for (Distance i = n - 1; i > 0; --i) {
+        auto value = std::move(*(begin + i));
+        *(begin + i) = std::move(*begin);
+        detail::sift_down(begin, i, Distance(0), std::move(value), less);
+    }
+}
+
+// Heap Sort: build_heap + extract_heap
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void heap_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    if (std::distance(begin, end) <= 1) return;
+    build_heap(begin, end, less);
+    extract_heap(begin, end, less);
+}
+
+// Bottom-up Heap Sort: ~n log n сравнений вместо ~2n log n у heap_sort,
+// выгоден при дорогих сравнениях (строки, составные ключи)
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void bottom_up_heap_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance n = std::distance(begin, end);
+    if (n <= 1) return;
+
+    for (Distance i = n / 2; i-- > 0; )
+        detail::sift_down_bottom_up(begin, n, i, std::move(*(begin + i)), less);
+
+    for (Distance i = n - 1; i > 0; --i) {
+        auto value = std::move(*(begin + i));
+        *(begin + i) = std::move(*begin);
+        detail::sift_down_bottom_up(begin, i, Distance(0), std::move(value), less);
+    }
+}
+
+// d-арный Heap Sort: heap_sort<4>(begin, end), heap_sort<8>(begin, end).
+// Меньшая высота кучи - меньше промахов кэша на больших массивах.
+template<std::size_t Arity, typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void heap_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    detail::dary_heap_sort<Arity, false>(begin, end, detail::make_less(std::move(comp), std::move(proj)));
+}
+
+// Heap Sort для массивов много больше L3: 4-арная куча с программной
+// предвыборкой внуков, задержка памяти скрывается за сравнениями
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void prefetch_heap_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    detail::dary_heap_sort<4, true>(begin, end, detail::make_less(std::move(comp), std::move(proj)));
+}
+
+// Heap Select: k = middle - begin первых в порядке comp элементов
+// собираются в [begin, middle) в виде max-кучи (*begin - k-й по порядку),
+// остаток [middle, end) - в произвольном порядке. O(n log k), без доп. памяти:
+// элемент не лучше вершины отбрасывается одним сравнением.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void heap_select(Iter begin, Iter middle, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance k = std::distance(begin, middle);
+    if (k == 0) return;
+    build_heap(begin, middle, less);
+    for (Iter it = middle; it != end; ++it) {
+        if (less(*it, *begin)) {
+            auto value = std::move(*it);
+            *it = std::move(*begin);
+            detail::sift_down(begin, k, Distance(0), std::move(value), less);
+        }
+    }
+}
+
+// Partial Heap Sort (аналог std::partial_sort): [begin, middle) - первые
+// middle - begin элементов в отсортированном порядке; heap_select + extract_heap
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void partial_heap_sort(Iter begin, Iter middle, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    heap_select(begin, middle, end, less);
+    extract_heap(begin, middle, less);
+}
+
+namespace detail {
+
+// Итератор на медиану из трех элементов
+template<typename Iter, typename Less>
+Iter median_of_3(Iter a, Iter b, Iter c, Less& less) {
+    if (less(*a, *b)) {
+        if (less(*b, *c)) return b;
+        return less(*a, *c) ? c : a;
+    }
+    if (less(*a, *c)) return a;
+    return less(*b, *c) ? c : b;
+}
+
+// Опорный элемент переносится в *first: медиана трех для небольших
+// отрезков, "ninther" (медиана трех медиан) для больших. Все образцы
+// берутся из [first + 1, last), поэтому там остаются элементы не меньше
+// и не больше опорного - сторожа для безусловного разбиения. Нужно
+// last - first >= 4: при n = 3 mid == first + 1 и медиана берется из двух
+// образцов, так что опорным может стать максимум без сторожа справа.
+template<typename Iter, typename Less>
+void move_pivot_to_first(Iter first, Iter last, Less& less) {
+    auto n = last - first;
+    Iter mid = first + n / 2;
+    Iter pivot;
+    if (n > 128) {
+        auto s = n / 8;
+        Iter m1 = median_of_3(first + 1, first + s, first + 2 * s, less);
+        Iter m2 = median_of_3(mid - s, mid, mid + s, less);
+        Iter m3 = median_of_3(last - 1 - 2 * s, last - 1 - s, last - 1, less);
+        pivot = median_of_3(m1, m2, m3, less);
+    } else {
+        pivot = median_of_3(first + 1, mid, last - 1, less);
+    }
+    std::iter_swap(first, pivot);
+}
+
+// Разбиение Хоара [first, last) относительно *pivot без проверок границ
+template<typename Iter, typename Less>
+Iter unguarded_partition(Iter first, Iter last, Iter pivot, Less& less) {
+    for (;;) {
+        while (less(*first, *pivot)) ++first;
+        --last;
+        while (less(*pivot, *last)) --last;
+        if (!(first < last)) return first;
+        std::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template<typename Iter, typename Distance, typename Less>
+void introsort_loop(Iter first, Iter last, Distance depth_limit, Distance cutoff, Less& less) {
+    // Отрезки из трех элементов не разбиваются (см. move_pivot_to_first)
+    cutoff = std::max(cutoff, Distance(3));
+    while (last - first > cutoff) {
+        if (depth_limit == 0) {
+            // Плохие опорные элементы: гарантированные O(n log n)
+            heap_sort(first, last, less);
+            return;
+        }
+        --depth_limit;
+        move_pivot_to_first(first, last, less);
+        Iter cut = unguarded_partition(first + 1, last, first, less);
+        // Рекурсия в правую часть, цикл по левой
+        introsort_loop(cut, last, depth_limit, cutoff, less);
+        last = cut;
+    }
+    small_sort(first, last, less);
+}
+
+} // namespace detail
+
+// Hybrid Sort (introsort): быстрая сортировка с медианой трех/ninther,
+// heap_sort при превышении глубины 2*log2(n) и small_sort на отрезках
+// не длиннее Cutoff. hybrid_sort<32>(begin, end) меняет порог; порог меньше
+// 3 поднимается до 3, для int/float с векторными ядрами он не меньше
+// simd::max_block_size.
+template<std::size_t Cutoff = 16, typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void hybrid_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    Distance n = std::distance(begin, end);
+    if (n <= 1) return;
+
+    Distance depth_limit = 0;
+    for (Distance k = n; k > 1; k >>= 1) depth_limit += 2;
+    Distance cutoff = static_cast<Distance>(Cutoff);
+    // С векторными ядрами выгоднее оставлять блоки до 64 элементов
+    if constexpr (detail::use_simd_block<Iter, decltype(less)>::value) {
+        if (simd::active_isa() != simd::Isa::SCALAR)
+            cutoff = std::max(cutoff, static_cast<Distance>(simd::max_block_size));
+    }
+    detail::introsort_loop(begin, end, depth_limit, cutoff, less);
+}
+
+namespace detail {
+
+template<std::size_t Bytes> struct unsigned_of;
+template<> struct unsigned_of<1> { using type = std::uint8_t; };
+template<> struct unsigned_of<2> { using type = std::uint16_t; };
+template<> struct unsigned_of<4> { using type = std::uint32_t; };
+template<> struct unsigned_of<8> { using type = std::uint64_t; };
+
+// Беззнаковый ключ с тем же порядком, что у значения: у знаковых целых
+// инвертируется знаковый бит, у IEEE float/double отрицательные числа
+// инвертируются целиком, а у положительных ставится знаковый бит.
+// NaN с знаковым битом попадают в начало, остальные NaN - в конец.
+template<typename T>
+struct radix_traits {
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "radix sort needs integer or floating-point keys");
+    using Key = typename unsigned_of<sizeof(T)>::type;
+    static constexpr Key sign_bit = static_cast<Key>(Key(1) << (sizeof(Key) * 8 - 1));
+
+    static Key key(const T& x) {
+        if constexpr (std::is_floating_point<T>::value) {
+            Key bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return (bits & sign_bit) ? static_cast<Key>(~bits) : static_cast<Key>(bits | sign_bit);
+        } else if constexpr (std::is_signed<T>::value) {
+            return static_cast<Key>(static_cast<Key>(x) ^ sign_bit);
+        } else {
+            return static_cast<Key>(x);
+        }
+    }
+};
+
+// Число значащих бит в x
+template<typename Key>
+std::size_t bit_width(Key x) {
+    std::size_t width = 0;
+    while (x != 0) { ++width; x = static_cast<Key>(x >> 1); }
+    return width;
+}
+
+// Ниже этого размера гистограммы дороже сортировки сравнениями
+constexpr std::size_t radix_sort_min_size = 256;
+
+} // namespace detail
+
+// Radix Sort (LSD) по цифрам из DigitBits бит (8, 11 или 16) для целых
+// и float/double по возрастанию. Цифры берутся из key - min_key, поэтому
+// число проходов определяется диапазоном значений, а не шириной типа;
+// гистограммы всех цифр считаются за один проход, цифры, одинаковые у
+// всех элементов, пропускаются. Проходы чередуют массив и буфер размера n.
+template<std::size_t DigitBits = 8, typename Iter>
+void radix_sort(Iter begin, Iter end) {
+    static_assert(DigitBits == 8 || DigitBits == 11 || DigitBits == 16, "digit must be 8, 11 or 16 bits");
+    using T = typename std::iterator_traits<Iter>::value_type;
+    using Traits = detail::radix_traits<T>;
+    using Key = typename Traits::Key;
+    constexpr std::size_t radix = std::size_t(1) << DigitBits;
+    constexpr std::size_t mask = radix - 1;
+
+    const std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n < detail::radix_sort_min_size) {
+        hybrid_sort(begin, end);
+        return;
+    }
+
+    Key min_key = Traits::key(*begin), max_key = min_key;
+    for (Iter it = begin; it != end; ++it) {
+        Key k = Traits::key(*it);
+        if (k < min_key) min_key = k;
+        if (k > max_key) max_key = k;
+    }
+    const std::size_t digits = (detail::bit_width(static_cast<Key>(max_key - min_key)) + DigitBits - 1) / DigitBits;
+    if (digits == 0) return;  // все ключи равны
+
+    // Гистограммы всех цифр за один проход
+    std::vector<std::size_t> counts(digits * radix, 0);
+    for (Iter it = begin; it != end; ++it) {
+        Key k = static_cast<Key>(Traits::key(*it) - min_key);
+        for (std::size_t d = 0; d < digits; ++d)
+            ++counts[d * radix + ((k >> (d * DigitBits)) & mask)];
+    }
+
+    std::vector<T> buffer(n);
+    bool in_buffer = false;
+    auto pass = [&](auto src, auto dst, std::size_t d) {
+        std::size_t* offsets = counts.data() + d * radix;
+        std::size_t total = 0;
+        for (std::size_t b = 0; b < radix; ++b) {
+            std::size_t c = offsets[b];
+            offsets[b] = total;
+            total += c;
+        }
+        for (std::size_t i = 0; i < n; ++i, ++src) {
+            Key k = static_cast<Key>(Traits::key(*src) - min_key);
+            *(dst + static_cast<std::ptrdiff_t>(offsets[(k >> (d * DigitBits)) & mask]++)) = std::move(*src);
+        }
+    };
+
+    for (std::size_t d = 0; d < digits; ++d) {
+        // Цифра одинакова у всех элементов - проход ничего не меняет
+        bool trivial = false;
+        for (std::size_t b = 0; b < radix && !trivial; ++b) trivial = (counts[d * radix + b] == n);
+        if (trivial) continue;
+
+        if (in_buffer) pass(buffer.begin(), begin, d);
+        else pass(begin, buffer.begin(), d);
+        in_buffer = !in_buffer;
+    }
+    if (in_buffer) std::move(buffer.begin(), buffer.end(), begin);
+}
+
+namespace detail {
+
+// Разбиение Дейкстры ("голландский флаг") относительно *first:
+// [first, lt) < pivot, [lt, gt) == pivot, [gt, last) > pivot.
+// Опорный элемент хранится вне массива, его место ("дырка") остается
+// в средней части и в конце заполняется им же.
+template<typename Iter, typename Less>
+std::pair<Iter, Iter> partition3(Iter first, Iter last, Less& less) {
+    auto pivot = std::move(*first);
+    Iter hole = first, lt = first, i = first + 1, gt = last;
+    while (i < gt) {
+        if (less(*i, pivot)) {
+            if (hole == lt) hole = i;
+            std::iter_swap(lt++, i++);
+        } else if (less(pivot, *i)) {
+            std::iter_swap(i, --gt);
+        } else {
+            ++i;
+        }
+    }
+    *hole = std::move(pivot);
+    return {lt, gt};
+}
+
+template<typename Iter, typename Distance, typename Less>
+void three_way_loop(Iter first, Iter last, Distance depth_limit, Less& less) {
+    while (last - first > 16) {
+        if (depth_limit == 0) {
+            heap_sort(first, last, less);
+            return;
+        }
+        --depth_limit;
+        move_pivot_to_first(first, last, less);
+        auto bounds = partition3(first, last, less);
+        // Равные опорному уже на месте; рекурсия в меньшую часть
+        if (bounds.first - first < last - bounds.second) {
+            three_way_loop(first, bounds.first, depth_limit, less);
+            first = bounds.second;
+        } else {
+            three_way_loop(bounds.second, last, depth_limit, less);
+            last = bounds.first;
+        }
+    }
+    small_sort(first, last, less);
+}
+
+// Наибольший диапазон значений для counting_sort в cardinality_aware_sort
+constexpr std::size_t counting_sort_max_range = std::size_t(1) << 20;
+
+} // namespace detail
+
+// 3-way Quick Sort: разбиение на <, ==, > опорного, поэтому каждый ключ
+// участвует в разбиениях, пока не станет опорным, - O(n * число ключей)
+// при сильном дублировании. Глубина ограничена как в hybrid_sort.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void three_way_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    Distance n = std::distance(begin, end);
+    if (n <= 1) return;
+
+    Distance depth_limit = 0;
+    for (Distance k = n; k > 1; k >>= 1) depth_limit += 2;
+    detail::three_way_loop(begin, end, depth_limit, less);
+}
+
+// Counting Sort для целых: подсчет каждого значения из [min, max] и
+// запись подряд. O(n + max - min) времени и памяти под счетчики.
+template<typename Iter>
+void counting_sort(Iter begin, Iter end) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    static_assert(std::is_integral<T>::value, "counting sort needs integer keys");
+    if (begin == end) return;
+
+    auto bounds = std::minmax_element(begin, end);
+    T min_value = *bounds.first;
+    std::size_t range = static_cast<std::size_t>(
+        static_cast<long long>(*bounds.second) - static_cast<long long>(min_value)) + 1;
+
+    std::vector<std::size_t> counts(range, 0);
+    for (Iter it = begin; it != end; ++it)
+        ++counts[static_cast<std::size_t>(static_cast<long long>(*it) - static_cast<long long>(min_value))];
+
+    Iter out = begin;
+    for (std::size_t v = 0; v < range; ++v) {
+        T value = static_cast<T>(static_cast<long long>(min_value) + static_cast<long long>(v));
+        for (std::size_t c = counts[v]; c > 0; --c) *out++ = value;
+    }
+}
+
+// Стратегия cardinality_aware_sort
+enum class SortStrategy {
+    COUNTING,   // целые с диапазоном не больше n
+    THREE_WAY,  // много повторов: three_way_sort
+    GENERAL     // hybrid_sort
+};
+
+inline const char* strategy_name(SortStrategy strategy) {
+    switch (strategy) {
+        case SortStrategy::COUNTING: return "counting";
+        case SortStrategy::THREE_WAY: return "3-way";
+        default: return "general";
+    }
+}
+
+// Выбор стратегии по выборке до 4096 элементов: оценка диапазона (для
+// целых без проекции, затем точный min/max за один проход) и доли
+// повторов среди выбранных ключей
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+SortStrategy choose_sort_strategy(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    const std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n < 1024) return SortStrategy::GENERAL;
+
+    const std::size_t sample_size = std::min<std::size_t>(n / 16, 4096);
+    std::vector<Iter> sample(sample_size);
+    for (std::size_t i = 0; i < sample_size; ++i) {
+        std::uint64_t h = (static_cast<std::uint64_t>(i) + 1) * 0x9E3779B97F4A7C15ull;
+        sample[i] = begin + static_cast<std::ptrdiff_t>(h % n);
+    }
+    auto deref_less = [&less](const Iter& a, const Iter& b) { return less(*a, *b); };
+    hybrid_sort(sample.begin(), sample.end(), deref_less);
+
+    if constexpr (std::is_integral<T>::value && detail::is_plain_less<decltype(less), T>::value) {
+        long long sample_range = static_cast<long long>(*sample.back()) - static_cast<long long>(*sample.front());
+        if (static_cast<std::size_t>(sample_range) < std::min(n, detail::counting_sort_max_range)) {
+            auto bounds = std::minmax_element(begin, end);
+            long long range = static_cast<long long>(*bounds.second) - static_cast<long long>(*bounds.first);
+            if (static_cast<std::size_t>(range) < std::min(n, detail::counting_sort_max_range))
+                return SortStrategy::COUNTING;
+        }
+    }
+
+    std::size_t distinct = 1;
+    for (std::size_t i = 1; i < sample_size; ++i)
+        if (less(*sample[i - 1], *sample[i])) ++distinct;
+    // Больше половины выборки - повторы уже встреченных ключей
+    if (2 * distinct <= sample_size) return SortStrategy::THREE_WAY;
+    return SortStrategy::GENERAL;
+}
+
+// Сортировка с учетом числа различных ключей: counting_sort, three_way_sort
+// или hybrid_sort по choose_sort_strategy
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void cardinality_aware_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    switch (choose_sort_strategy(begin, end, less)) {
+        case SortStrategy::COUNTING:
+            if constexpr (std::is_integral<T>::value) counting_sort(begin, end);
+            return;
+        case SortStrategy::THREE_WAY:
+            three_way_sort(begin, end, less);
+            return;
+        default:
+            hybrid_sort(begin, end, less);
+            return;
+    }
+}
+
+namespace detail {
+
+// Короткие естественные серии дополняются до этой длины insertion_sort
+constexpr std::ptrdiff_t adaptive_min_run = 32;
+// Побед одной стороны подряд до перехода в режим галопа
+constexpr int adaptive_min_gallop = 7;
+
+// Конец естественной серии, начинающейся в first: неубывающей или строго
+// убывающей (строгость сохраняет устойчивость при развороте)
+template<typename Iter, typename Less>
+Iter natural_run_end(Iter first, Iter last, Less& less, bool& descending) {
+    descending = false;
+    Iter it = first + 1;
+    if (it == last) return it;
+    if (less(*it, *first)) {
+        descending = true;
+        while (++it != last && less(*it, *(it - 1))) {}
+    } else {
+        while (++it != last && !less(*it, *(it - 1))) {}
+    }
+    return it;
+}
+
+// Галоп слева: первый p в [first, last), для которого pred(*p) ложно,
+// если pred истинно на префиксе. Шаги 1, 3, 7, ... затем бинарный поиск.
+template<typename Iter, typename Pred>
+Iter gallop_forward(Iter first, Iter last, Pred pred) {
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance size = last - first, lo = 0, hi = 1;
+    while (hi < size && pred(*(first + hi))) {
+        lo = hi + 1;
+        hi = 2 * hi + 1;
+    }
+    if (hi > size) hi = size;
+    if (lo > hi) lo = hi;
+    return std::partition_point(first + lo, first + hi, pred);
+}
+
+// Галоп справа: начало наибольшего суффикса [p, last), на котором pred истинно
+template<typename Iter, typename Pred>
+Iter gallop_backward(Iter first, Iter last, Pred pred) {
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    Distance size = last - first, lo = 0, hi = 1;
+    // lo, hi - отступы от last
+    while (hi <= size && pred(*(last - hi))) {
+        lo = hi;
+        hi = 2 * hi + 1;
+    }
+    if (hi > size) hi = size + 1;
+    // Суффикс длины lo подходит, длины hi - нет (или hi > size)
+    Iter from = last - (hi - 1), to = last - lo;
+    return std::partition_point(from, to, [&pred](const auto& x) { return !pred(x); });
+}
+
+// Слияние соседних серий [lo, mid) и [mid, hi) через буфер; меньшая серия
+// перемещается в буфер, при серии побед одной стороны - галоп
+template<typename Iter, typename Buffer, typename Less>
+void merge_runs(Iter lo, Iter mid, Iter hi, Buffer& buffer, Less& less) {
+    // Начало левой серии, не большее *mid, и конец правой, не меньший
+    // *(mid - 1), уже на своих местах
+    lo = gallop_forward(lo, mid, [&](const auto& x) { return !less(*mid, x); });
+    if (lo == mid) return;
+    hi = gallop_backward(mid, hi, [&](const auto& x) { return !less(x, *(mid - 1)); });
+    if (mid == hi) return;
+
+    auto buf = buffer.begin();
+    int min_gallop = adaptive_min_gallop;
+    if (mid - lo <= hi - mid) {
+        // Слева направо: левая серия в буфере
+        auto a = buf, a_end = std::move(lo, mid, buf);
+        Iter b = mid, out = lo;
+        int wins_a = 0, wins_b = 0;
+        while (a != a_end && b != hi) {
+            if (less(*b, *a)) {
+                *out++ = std::move(*b++);
+                wins_a = 0;
+                if (++wins_b >= min_gallop) {
+                    Iter stop = gallop_forward(b, hi, [&](const auto& x) { return less(x, *a); });
+                    out = std::move(b, stop, out);
+                    b = stop;
+                    wins_b = 0;
+                }
+            } else {
+                *out++ = std::move(*a++);
+                wins_b = 0;
+                if (++wins_a >= min_gallop && b != hi) {
+                    auto stop = gallop_forward(a, a_end, [&](const auto& x) { return !less(*b, x); });
+                    out = std::move(a, stop, out);
+                    a = stop;
+                    wins_a = 0;
+                }
+            }
+        }
+        std::move(a, a_end, out);
+    } else {
+        // Справа налево: правая серия в буфере
+        auto b_begin = buf, b = std::move(mid, hi, buf);
+        Iter a = mid, out = hi;
+        int wins_a = 0, wins_b = 0;
+        while (a != lo && b != b_begin) {
+            if (less(*(b - 1), *(a - 1))) {
+                *--out = std::move(*--a);
+                wins_b = 0;
+                if (++wins_a >= min_gallop && a != lo) {
+                    Iter stop = gallop_backward(lo, a, [&](const auto& x) { return less(*(b - 1), x); });
+                    out = std::move_backward(stop, a, out);
+                    a = stop;
+                    wins_a = 0;
+                }
+            } else {
+                *--out = std::move(*--b);
+                wins_a = 0;
+                if (++wins_b >= min_gallop && b != b_begin) {
+                    auto stop = gallop_backward(b_begin, b, [&](const auto& x) { return !less(x, *(a - 1)); });
+                    out = std::move_backward(stop, b, out);
+                    b = stop;
+                    wins_b = 0;
+                }
+            }
+        }
+        std::move_backward(b_begin, b, out);
+    }
+}
+
+// Приоритет узла powersort для соседних серий [begin_a, begin_b) и
+// [begin_b, end_b) в массиве длины n: число совпадающих старших бит
+// двоичных записей их середин (в долях n)
+inline int powersort_node_power(std::size_t n, std::size_t begin_a, std::size_t begin_b, std::size_t end_b) {
+    std::size_t two_n = 2 * n;
+    std::size_t l = begin_a + begin_b, r = begin_b + end_b;
+    int power = 0;
+    for (;;) {
+        ++power;
+        if (l >= two_n) {
+            l -= two_n;
+            r -= two_n;
+        } else if (r >= two_n) {
+            break;
+        }
+        l <<= 1;
+        r <<= 1;
+    }
+    return power;
+}
+
+} // namespace detail
+
+// Число естественных серий (Runs - мера упорядоченности): 1 у отсортированного
+// и обратного массивов, около 0.4n у случайного. Строго убывающие серии
+// считаются так же, как их находит adaptive_sort.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+std::size_t count_runs(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    std::size_t runs = 0;
+    bool descending;
+    for (Iter it = begin; it != end; it = detail::natural_run_end(it, end, less, descending)) ++runs;
+    return runs;
+}
+
+// Adaptive Sort (устойчивая, в стиле TimSort/powersort): один проход находит
+// естественные серии, убывающие разворачиваются, короткие дополняются
+// insertion_sort до adaptive_min_run; серии сливаются с галопом в порядке,
+// заданном приоритетами powersort. Отсортированный и обратный массивы -
+// одна серия, O(n). Буфер - не больше n/2 элементов.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void adaptive_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    const std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n <= 1) return;
+
+    struct Run {
+        std::size_t begin, end;
+        int power;
+    };
+    std::vector<Run> stack;
+    std::vector<T> buffer;
+
+    auto next_run = [&](std::size_t from) {
+        bool descending;
+        Iter first = begin + static_cast<std::ptrdiff_t>(from);
+        Iter run_end = detail::natural_run_end(first, end, less, descending);
+        if (descending) std::reverse(first, run_end);
+        if (run_end - first < detail::adaptive_min_run) {
+            run_end = first + std::min<std::ptrdiff_t>(detail::adaptive_min_run, end - first);
+            insertion_sort(first, run_end, less);
+        }
+        return static_cast<std::size_t>(run_end - begin);
+    };
+    auto merge = [&](std::size_t lo, std::size_t mid, std::size_t hi) {
+        std::size_t smaller = std::min(mid - lo, hi - mid);
+        if (buffer.size() < smaller) buffer.resize(smaller);
+        detail::merge_runs(begin + static_cast<std::ptrdiff_t>(lo), begin + static_cast<std::ptrdiff_t>(mid),
+                           begin + static_cast<std::ptrdiff_t>(hi), buffer, less);
+    };
+
+    Run current{0, next_run(0), 0};
+    while (current.end < n) {
+        std::size_t next_end = next_run(current.end);
+        int power = detail::powersort_node_power(n, current.begin, current.end, next_end);
+        while (!stack.empty() && stack.back().power > power) {
+            merge(stack.back().begin, current.begin, current.end);
+            current.begin = stack.back().begin;
+            stack.pop_back();
+        }
+        stack.push_back({current.begin, current.end, power});
+        current = {current.end, next_end, 0};
+    }
+    while (!stack.empty()) {
+        merge(stack.back().begin, current.begin, current.end);
+        current.begin = stack.back().begin;
+        stack.pop_back();
+    }
+}
+
+} // namespace coursework
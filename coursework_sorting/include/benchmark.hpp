@@ -1,4 +1,7 @@
 #pragma once
+#include "op_counter.hpp"
+#include "perf_counters.hpp"
+#include "statistics.hpp"
 #include <vector>
 #include <string>
 #include <cstddef>
@@ -12,20 +15,201 @@ enum class DataType {
     ALMOST_SORTED
 };
 
+// "random", "sorted", "reversed", "almost-sorted"
+const char* data_type_name(DataType type);
+
+// Вариант Heap Sort, замеряемый в колонке "Heap Sort"
+enum class HeapSortVariant {
+    CLASSIC,
+    BOTTOM_UP
+};
+
+// Порядок замеров run_single_test: warmup_runs прогонов без записи, затем
+// не меньше iterations замеров. При target_ci > 0 замеры продолжаются,
+// пока полуширина 95% ДИ медианы какого-либо алгоритма больше target_ci
+// от медианы (проверка каждые iterations замеров), но не дольше
+// max_samples замеров. hardware_counters - снимать аппаратные счетчики
+// (PerfCounters) на каждом замеряемом участке; включение и чтение
+// счетчиков остаются вне замеров времени. input_pool - все входы
+// генерируются заранее (InputPool), в цикле замеров нет выделений памяти;
+// false - генерация и новые копии на каждом замере.
+//
+// min_batch_us > 0 (только с input_pool) - один замер это пакет из k
+// сортировок разных входов подряд, время и счетчики делятся на k. k
+// подбирается по std::sort так, чтобы пакет длился не меньше min_batch_us
+// (не больше 4096 сортировок): на малых массивах одиночный замер
+// сравним с разрешением и накладными расходами часов. cycle_clock - часы
+// по TSC (cycle_clock.hpp) вместо high_resolution_clock, если TSC
+// инвариантный.
+struct MeasurementOptions {
+    size_t warmup_runs = 1;
+    bool reject_outliers = true;
+    double target_ci = 0.0;
+    size_t max_samples = 0;
+    bool hardware_counters = false;
+    bool input_pool = true;
+    double min_batch_us = 0.0;
+    bool cycle_clock = false;
+};
+
+// Распределение замеров одного алгоритма, микросекунды; counters -
+// среднее на один замер (-1, если счетчики выключены или недоступны)
+struct TimingStats {
+    std::string algorithm;
+    SampleStats stats;
+    CounterValues counters;
+};
+
+// Поля *_time - медианы замеров без выбросов, полные распределения -
+// в timings (в порядке колонок таблицы RESULTS)
 struct BenchmarkResult {
+    size_t array_size = 0;
+    size_t iterations = 0;  // записанных замеров
+    size_t warmup_runs = 0;
+    bool input_pool = false;
+    size_t batch_size = 1;          // сортировок в одном замере
+    double tsc_ticks_per_ns = -1.0; // частота TSC, если замеры по TSC
+    double insertion_sort_time = -1.0;
+    double heap_sort_time = -1.0;
+    double std_sort_time = -1.0;
+    double hybrid_sort_time = -1.0;
+    double binary_insertion_sort_time = -1.0;
+    // simd::simd_sort (векторные ядра AVX2/AVX-512 или скалярный путь)
+    double simd_sort_time = -1.0;
+    // radix_sort (LSD, 8-битные цифры)
+    double radix_sort_time = -1.0;
+    // adaptive_sort и мера упорядоченности: число естественных серий
+    // на первом входе (1 - отсортирован или обратный, ~0.4n - случайный)
+    double adaptive_sort_time = -1.0;
+    size_t natural_runs = 0;
+    // Фазы classic heap_sort: построение кучи и извлечение (сумма - heap_sort_time),
+    // параллельное построение на ThreadPool::global() (потоков: heap_build_threads)
+    double heap_build_time = -1.0;
+    double heap_extract_time = -1.0;
+    double parallel_heap_build_time = -1.0;
+    size_t heap_build_threads = 0;
+    // Число сравнений на одном входе (для оценки bottom-up варианта)
+    size_t heap_sort_comparisons = 0;
+    size_t bottom_up_heap_sort_comparisons = 0;
+    std::vector<TimingStats> timings;
+    // Только при MeasurementOptions::hardware_counters: PerfCounters::status()
+    // - открытые счетчики или причина недоступности
+    bool counters_available = false;
+    std::string counters_status;
+};
+
+// Результаты на тяжелых элементах (std::string, 64-байтные записи):
+// время и число копирований/перемещений элементов на одном входе
+struct PayloadResult {
+    std::string element_type;
     size_t array_size = 0;
     size_t iterations = 0;
     double insertion_sort_time = -1.0;
     double heap_sort_time = -1.0;
     double std_sort_time = -1.0;
+    size_t insertion_sort_copies = 0;
+    size_t insertion_sort_moves = 0;
+    size_t heap_sort_copies = 0;
+    size_t heap_sort_moves = 0;
+};
+
+// Малые массивы: среднее время сортировки одного массива в наносекундах
+struct SmallArrayResult {
+    size_t array_size = 0;
+    size_t arrays = 0;
+    double insertion_sort_ns = -1.0;
+    double small_sort_ns = -1.0;
+    double std_sort_ns = -1.0;
+    // simd::sort_block, только для размеров <= simd::max_block_size
+    double simd_block_ns = -1.0;
+};
+
+// Сильное дублирование: distinct_values различных ключей на array_size
+// элементов; strategy - выбор cardinality_aware_sort
+struct DuplicatesResult {
+    size_t array_size = 0;
+    int distinct_values = 0;
+    size_t iterations = 0;
+    std::string strategy;
+    double heap_sort_time = -1.0;
+    double std_sort_time = -1.0;
+    double three_way_sort_time = -1.0;
+    double cardinality_sort_time = -1.0;
+};
+
+// Очередь с приоритетом: миллионы операций в секунду на куче из heap_size
+// элементов. workload "mixed" - случайные push/pop поровну, "hold" - pop
+// и push нового элемента (у Heap - один pop_push)
+struct PriorityQueueResult {
+    size_t heap_size = 0;
+    size_t operations = 0;
+    std::string workload;
+    double std_queue_mops = -1.0;
+    double heap2_mops = -1.0;
+    double heap4_mops = -1.0;
+};
+
+// k-way merge runs серий по run_length элементов: время и сравнения
+// на один выходной элемент
+struct KwayMergeResult {
+    size_t runs = 0;
+    size_t run_length = 0;
+    size_t iterations = 0;
+    double loser_tree_ns = -1.0;
+    double heap_ns = -1.0;
+    double loser_tree_comparisons = -1.0;
+    double heap_comparisons = -1.0;
+};
+
+// Операции над элементами (обертка Counted<int>) при сортировке одного
+// входа; не зависят от машины. Нормировки на n log2 n и n^2 - в печати и CSV.
+struct OperationCountResult {
+    std::string algorithm;
+    DataType data_type = DataType::RANDOM;
+    size_t array_size = 0;
+    OpCounts counts;
 };
 
 class Benchmark {
 public:
+    void set_heap_variant(HeapSortVariant variant) { heap_variant_ = variant; }
+    void set_measurement(const MeasurementOptions& options) { measurement_ = options; }
+
     BenchmarkResult run_single_test(size_t array_size, size_t iterations, DataType data_type);
     std::vector<BenchmarkResult> run_test_suite(const std::vector<size_t>& sizes, size_t iterations, DataType data_type);
     void print_results(const std::vector<BenchmarkResult>& results);
+    // Кроме filename пишет <имя>_stats.csv: статистики и сырые замеры
+    // каждого алгоритма
     void save_to_csv(const std::vector<BenchmarkResult>& results, const std::string& filename);
+
+    std::vector<PayloadResult> run_payload_test(size_t array_size, size_t iterations, DataType data_type);
+    void print_payload_results(const std::vector<PayloadResult>& results);
+
+    std::vector<SmallArrayResult> run_small_array_test(const std::vector<size_t>& sizes, size_t repeats);
+    void print_small_array_results(const std::vector<SmallArrayResult>& results);
+
+    std::vector<DuplicatesResult> run_duplicates_test(size_t array_size, size_t iterations,
+                                                      const std::vector<int>& distinct_counts);
+    void print_duplicates_results(const std::vector<DuplicatesResult>& results);
+
+    std::vector<PriorityQueueResult> run_priority_queue_test(const std::vector<size_t>& heap_sizes,
+                                                             size_t operations);
+    void print_priority_queue_results(const std::vector<PriorityQueueResult>& results);
+
+    std::vector<KwayMergeResult> run_kway_merge_test(const std::vector<size_t>& run_counts,
+                                                     const std::vector<size_t>& run_lengths);
+    void print_kway_merge_results(const std::vector<KwayMergeResult>& results);
+
+    // Режим "ops": точные счетчики операций по размерам и типам данных
+    std::vector<OperationCountResult> run_operation_count_test(const std::vector<size_t>& sizes,
+                                                               const std::vector<DataType>& data_types);
+    void print_operation_count_results(const std::vector<OperationCountResult>& results);
+    void save_operation_counts_to_csv(const std::vector<OperationCountResult>& results,
+                                      const std::string& filename);
+
+private:
+    HeapSortVariant heap_variant_ = HeapSortVariant::CLASSIC;
+    MeasurementOptions measurement_;
 };
 
-} // namespace coursework
\ No newline at end of file
+} // namespace coursework
\ No newline at end of file
@@ -0,0 +1,37 @@
+// cycle_clock.hpp
+#pragma once
+
+#include <cstdint>
+
+#if defined(COURSEWORK_SIMD_X86) && defined(_MSC_VER)
+    #include <intrin.h>
+#elif defined(COURSEWORK_SIMD_X86)
+    #include <x86intrin.h>
+#endif
+
+namespace coursework {
+namespace cycle_clock {
+
+// Счетчик тактов TSC (rdtsc). Тики - опорные такты с постоянной частотой,
+// а не такты ядра: от турбо-частоты и энергосбережения не зависят, поэтому
+// годятся как часы. Используется только при инвариантном TSC
+// (CPUID 0x80000007, EDX бит 8); иначе available() == false.
+bool available();
+
+// Текущее значение TSC без проверки available(), чтобы не тратить такты
+// в замерах: на x86 rdtsc выполняется всегда, на других платформах - 0.
+// Вызывающий проверяет available() заранее, как run_single_test.
+inline std::uint64_t now() {
+#if defined(COURSEWORK_SIMD_X86)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Тиков TSC в наносекунде: калибровка по steady_clock (~50 мс) при первом
+// вызове. -1 без available()
+double ticks_per_ns();
+
+} // namespace cycle_clock
+} // namespace coursework
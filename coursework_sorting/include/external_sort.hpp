@@ -0,0 +1,48 @@
+// external_sort.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace coursework {
+
+// Внешняя сортировка двоичных файлов int32 (порядок байт платформы),
+// которые не помещаются в память:
+//   1) серии длиной ~2x бюджета - выбор с замещением на куче Heap,
+//   2) серии сбрасываются во временные файлы,
+//   3) многопроходное k-way слияние (kway_merge) с большими
+//      последовательными буферами чтения/записи.
+struct ExternalSortOptions {
+    // Вся память сортировки: куча отбора и буферы ввода-вывода
+    std::size_t memory_budget = std::size_t(256) << 20;
+    // Буфер одного файла; число сливаемых за проход серий -
+    // memory_budget / io_buffer_size - 1
+    std::size_t io_buffer_size = std::size_t(4) << 20;
+    // Каталог временных файлов (пусто - системный)
+    std::string temp_dir;
+};
+
+struct ExternalSortStats {
+    std::uint64_t elements = 0;
+    std::uint64_t bytes = 0;
+    std::size_t heap_elements = 0; // емкость массива выбора с замещением
+    std::size_t runs = 0;          // серий после первой фазы
+    std::size_t merge_passes = 0;  // проходов слияния, включая последний
+    std::size_t fan_in = 0;
+    double run_generation_seconds = 0.0;
+    double merge_seconds = 0.0;
+};
+
+// Сортирует input в output (файлы не должны совпадать), бросает
+// std::runtime_error при ошибке ввода-вывода
+ExternalSortStats external_sort(const std::string& input, const std::string& output,
+                                const ExternalSortOptions& options = {});
+
+// count случайных int32 в path, порциями без загрузки файла в память
+void write_random_file(const std::string& path, std::uint64_t count);
+
+// Проверка упорядоченности файла за один последовательный проход
+bool is_sorted_file(const std::string& path);
+
+} // namespace coursework
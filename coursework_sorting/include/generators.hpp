@@ -1,13 +1,47 @@
 #pragma once
 #include <vector>
 #include <cstddef>
+#include <string>
 #include "benchmark.hpp"  // теперь DataType берется отсюда
 
 namespace coursework {
 
+// 64-байтная запись: ключ сортировки + полезная нагрузка
+struct Record {
+    int key;
+    char payload[60];
+
+    bool operator>(const Record& other) const { return key > other.key; }
+    bool operator<(const Record& other) const { return key < other.key; }
+};
+
 class ArrayGenerator {
 public:
     std::vector<int> generate(size_t size, DataType type);
+    // Строки длиннее SSO-буфера: каждая копия - выделение памяти
+    std::vector<std::string> generate_strings(size_t size, DataType type);
+    std::vector<Record> generate_records(size_t size, DataType type);
+    // distinct различных значений в [-distinct/2, distinct - distinct/2),
+    // при distinct = 2001 - то же распределение, что у generate(RANDOM)
+    std::vector<int> generate_few_unique(size_t size, int distinct);
+};
+
+// Входы серии замеров, сгенерированные заранее в одном непрерывном буфере:
+// в цикле замеров нет ни генерации, ни выделения памяти. Если count входов
+// не помещаются в max_bytes, их меньше и input(i) берет их по кругу.
+class InputPool {
+public:
+    InputPool(ArrayGenerator& generator, size_t size, DataType type, size_t count,
+              size_t max_bytes = size_t(256) << 20);
+
+    size_t size() const { return size_; }
+    size_t count() const { return count_; }
+    const int* input(size_t i) const { return arena_.data() + (i % count_) * size_; }
+
+private:
+    size_t size_;
+    size_t count_;
+    std::vector<int> arena_;
 };
 
-} // namespace coursework
\ No newline at end of file
+} // namespace coursework
\ No newline at end of file
@@ -0,0 +1,269 @@
+// heap.hpp
+#pragma once
+
+#include "algorithms.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <utility>
+#include <vector>
+
+namespace coursework {
+
+// Очередь с приоритетом на d-арной куче: те же ядра просеивания, что
+// у heap_sort<Arity>. Как у std::priority_queue, top() - наибольший по comp
+// элемент, для min-кучи Compare = std::greater<>.
+// push_handle возвращает handle для изменения приоритета (decrease_key,
+// update). Учет позиций включается первым push_handle, до этого куча
+// работает без накладных расходов.
+template<typename T, typename Compare = std::less<>, std::size_t Arity = 4>
+class Heap {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    // Ссылка на элемент кучи. После извлечения элемента недействительна
+    // (id переиспользуется следующим push_handle).
+    struct Handle {
+        std::size_t id = npos;
+    };
+
+    Heap() = default;
+    explicit Heap(Compare comp) : less_{std::move(comp), identity{}} {}
+
+    // Построение из диапазона за O(n)
+    template<typename InputIt>
+    Heap(InputIt first, InputIt last, Compare comp = {})
+        : data_(first, last), less_{std::move(comp), identity{}} {
+        detail::build_heap_dary<Arity>(data_.begin(), data_.end(), less_);
+    }
+
+    bool empty() const { return data_.empty(); }
+    size_type size() const { return data_.size(); }
+
+    void reserve(size_type n) {
+        data_.reserve(n);
+        if (tracked_) slot_.reserve(n);
+    }
+
+    void clear() {
+        data_.clear();
+        slot_.clear();
+        pos_.clear();
+        free_ids_.clear();
+        tracked_ = false;
+    }
+
+    const T& top() const {
+        assert(!empty());
+        return data_.front();
+    }
+
+    void push(T value) {
+        if (tracked_) slot_.push_back(npos);
+        push_back_and_sift(std::move(value));
+    }
+
+    Handle push_handle(T value) {
+        if (!tracked_) {
+            slot_.assign(data_.size(), npos);
+            tracked_ = true;
+        }
+        Handle handle{acquire_id()};
+        slot_.push_back(handle.id);
+        push_back_and_sift(std::move(value));
+        return handle;
+    }
+
+    void pop() {
+        assert(!empty());
+        if (tracked_) {
+            release_id(slot_.front());
+            slot_.front() = slot_.back();
+            slot_.pop_back();
+        }
+        T value = std::move(data_.back());
+        data_.pop_back();
+        if (data_.empty()) return;
+        // Последний элемент почти всегда возвращается к листьям
+        Distance n = static_cast<Distance>(data_.size());
+        with_moves([&](auto moves) {
+            detail::sift_down_bottom_up_dary<Arity>(data_.begin(), n, Distance(0), std::move(value), less_, moves);
+        });
+    }
+
+    // Замена вершины: pop() + push(value) за одно просеивание.
+    // Возвращает прежнюю вершину.
+    T pop_push(T value) {
+        assert(!empty());
+        T old_top = std::move(data_.front());
+        if (tracked_) {
+            release_id(slot_.front());
+            slot_.front() = npos;
+        }
+        sift_down(0, std::move(value));
+        return old_top;
+    }
+
+    bool contains(Handle handle) const {
+        return handle.id < pos_.size() && pos_[handle.id] != npos;
+    }
+
+    const T& value(Handle handle) const {
+        assert(contains(handle));
+        return data_[pos_[handle.id]];
+    }
+
+    // Повышение приоритета (decrease-key для min-кучи): value не должен
+    // быть меньше текущего значения по comp, элемент только поднимается
+    void decrease_key(Handle handle, T value) {
+        assert(contains(handle));
+        Distance hole = static_cast<Distance>(pos_[handle.id]);
+        assert(!less_(value, data_[hole]));
+        sift_up(hole, std::move(value));
+    }
+
+    // Произвольное изменение значения: элемент поднимается или опускается
+    void update(Handle handle, T value) {
+        assert(contains(handle));
+        Distance hole = static_cast<Distance>(pos_[handle.id]);
+        if (less_(data_[hole], value)) sift_up(hole, std::move(value));
+        else sift_down(hole, std::move(value));
+    }
+
+private:
+    using Distance = typename std::vector<T>::difference_type;
+
+    // slot[i] - id элемента в позиции i (npos без handle), pos[id] - позиция
+    struct Tracker {
+        std::size_t* slot;
+        std::size_t* pos;
+        std::size_t id = npos;
+
+        void lifted(Distance hole) { id = slot[hole]; }
+        void moved(Distance to, Distance from) {
+            slot[to] = slot[from];
+            if (slot[to] != npos) pos[slot[to]] = static_cast<std::size_t>(to);
+        }
+        void placed(Distance to) {
+            slot[to] = id;
+            if (id != npos) pos[id] = static_cast<std::size_t>(to);
+        }
+    };
+
+    template<typename Kernel>
+    void with_moves(Kernel kernel) {
+        if (tracked_) kernel(Tracker{slot_.data(), pos_.data()});
+        else kernel(detail::no_heap_moves{});
+    }
+
+    void sift_up(Distance hole, T value) {
+        with_moves([&](auto moves) {
+            detail::sift_up_dary<Arity>(data_.begin(), hole, std::move(value), less_, moves);
+        });
+    }
+
+    void sift_down(Distance hole, T value) {
+        Distance n = static_cast<Distance>(data_.size());
+        with_moves([&](auto moves) {
+            detail::sift_down_dary<Arity>(data_.begin(), n, hole, std::move(value), less_, moves);
+        });
+    }
+
+    void push_back_and_sift(T value) {
+        data_.push_back(std::move(value));
+        Distance hole = static_cast<Distance>(data_.size()) - 1;
+        sift_up(hole, std::move(data_.back()));
+    }
+
+    std::size_t acquire_id() {
+        if (!free_ids_.empty()) {
+            std::size_t id = free_ids_.back();
+            free_ids_.pop_back();
+            return id;
+        }
+        pos_.push_back(npos);
+        return pos_.size() - 1;
+    }
+
+    void release_id(std::size_t id) {
+        if (id == npos) return;
+        pos_[id] = npos;
+        free_ids_.push_back(id);
+    }
+
+    std::vector<T> data_;
+    detail::projected_less<Compare, identity> less_{};
+
+    bool tracked_ = false;
+    std::vector<std::size_t> slot_;
+    std::vector<std::size_t> pos_;
+    std::vector<std::size_t> free_ids_;
+};
+
+// Потоковый top-k: k первых в порядке comp элементов среди всех поданных
+// (по умолчанию k наименьших, для k наибольших - std::greater<>).
+// Память O(k), работа O(n log k): вершина кучи - текущая граница отбора,
+// элемент не лучше нее отбрасывается одним сравнением без копирования.
+template<typename T, typename Compare = std::less<>, std::size_t Arity = 4>
+class TopK {
+public:
+    explicit TopK(std::size_t k, Compare comp = {}) : k_(k), heap_(comp), comp_(std::move(comp)) {
+        heap_.reserve(k);
+    }
+
+    std::size_t capacity() const { return k_; }
+    std::size_t size() const { return heap_.size(); }
+    bool empty() const { return heap_.empty(); }
+
+    void push(const T& value) {
+        if (heap_.size() < k_) heap_.push(value);
+        else if (k_ > 0 && std::invoke(comp_, value, heap_.top())) heap_.pop_push(value);
+    }
+
+    // Очередной фрагмент входа
+    template<typename InputIt>
+    void consume(InputIt first, InputIt last) {
+        for (; first != last && heap_.size() < k_; ++first) heap_.push(*first);
+        if (k_ == 0) return;
+        // Куча заполнена: основной цикл - одно сравнение с вершиной
+        for (; first != last; ++first)
+            if (std::invoke(comp_, *first, heap_.top())) heap_.pop_push(*first);
+    }
+
+    // Чтение из потока до конца или первой ошибки формата
+    void consume(std::istream& in) {
+        T value;
+        while (in >> value) push(value);
+    }
+
+    // k-й по порядку элемент (при size() == capacity())
+    const T& threshold() const { return heap_.top(); }
+
+    // Отобранные элементы в порядке comp
+    std::vector<T> sorted() const {
+        Heap<T, Compare, Arity> rest = heap_;
+        std::vector<T> result;
+        result.reserve(rest.size());
+        while (!rest.empty()) {
+            result.push_back(rest.top());
+            rest.pop();
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+private:
+    std::size_t k_;
+    Heap<T, Compare, Arity> heap_;
+    Compare comp_;
+};
+
+} // namespace coursework
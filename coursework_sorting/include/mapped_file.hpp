@@ -0,0 +1,58 @@
+// mapped_file.hpp
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace coursework {
+
+// Подсказка ядру о порядке доступа к отображению (madvise)
+enum class MapAdvice {
+    NONE,        // не вызывать madvise
+    NORMAL,
+    SEQUENTIAL,  // агрессивное упреждающее чтение
+    RANDOM,      // без упреждающего чтения
+    WILLNEED     // начать чтение всего файла сразу
+};
+
+const char* advice_name(MapAdvice advice);
+
+// Файл, отображенный в память для чтения и записи (MAP_SHARED): изменения
+// попадают в файл без явной записи, sync() дожидается их сброса на диск.
+// Только POSIX; ошибки - std::runtime_error с текстом errno.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    void* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    void advise(MapAdvice advice);
+    // msync(MS_SYNC)
+    void sync();
+
+private:
+    std::string path_;
+    int fd_ = -1;
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Страничные прерывания процесса с момента запуска (getrusage):
+// minor - страница уже в page cache, major - чтение с диска
+struct PageFaults {
+    long minor = 0;
+    long major = 0;
+};
+
+PageFaults page_faults();
+
+// Сбросить страницы файла из page cache (fdatasync + POSIX_FADV_DONTNEED),
+// чтобы следующий проход читал с диска. Работает без прав root.
+void evict_from_page_cache(const std::string& path);
+
+} // namespace coursework
@@ -0,0 +1,115 @@
+// merge.hpp
+#pragma once
+
+#include "algorithms.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace coursework {
+
+namespace detail {
+
+// Курсоры k отсортированных серий. beats(a, b) - элемент серии a выходит
+// раньше элемента серии b: исчерпанная серия проигрывает всем, при равных
+// элементах побеждает серия с меньшим номером (слияние устойчиво).
+// Одно сравнение на пару: порядок номеров выбирает, какое из двух нужно.
+template<typename Iter, typename Less>
+struct merge_cursors {
+    std::vector<Iter> pos;
+    std::vector<Iter> end;
+    Less less;
+
+    bool active(std::size_t run) { return pos[run] != end[run]; }
+
+    bool beats(std::size_t a, std::size_t b) {
+        if (!active(a)) return false;
+        if (!active(b)) return true;
+        return a < b ? !less(*pos[b], *pos[a]) : less(*pos[a], *pos[b]);
+    }
+};
+
+template<typename Iter, typename Less>
+merge_cursors<Iter, Less> make_merge_cursors(const std::vector<std::pair<Iter, Iter>>& runs, Less less) {
+    merge_cursors<Iter, Less> cursors{{}, {}, std::move(less)};
+    cursors.pos.reserve(runs.size());
+    cursors.end.reserve(runs.size());
+    for (const auto& run : runs) {
+        cursors.pos.push_back(run.first);
+        cursors.end.push_back(run.second);
+    }
+    return cursors;
+}
+
+} // namespace detail
+
+// k-way merge на дереве проигравших (loser tree, Knuth 5.4.1): во внутренних
+// узлах хранятся проигравшие, общий победитель - отдельно. После вывода
+// элемента его серия проходит путь лист-корень: ceil(log2 k) сравнений на
+// элемент против ~2 log2 k у двоичной кучи. Серии - пары [first, last)
+// (подходят и однопроходные итераторы), элементы копируются в out
+// (для перемещения - std::move_iterator), возвращается конец записанного.
+// Слияние устойчиво.
+template<typename Iter, typename OutIter, typename Compare = std::less<>, typename Proj = identity>
+OutIter kway_merge(const std::vector<std::pair<Iter, Iter>>& runs, OutIter out,
+                   Compare comp = {}, Proj proj = {}) {
+    auto cursors = detail::make_merge_cursors(runs, detail::make_less(std::move(comp), std::move(proj)));
+    const std::size_t k = runs.size();
+    if (k == 0) return out;
+
+    // Лист серии i - узел k + i, родитель узла v - v / 2
+    std::vector<std::size_t> tree(k);
+    std::vector<std::size_t> winner(k);
+    auto node_winner = [&](std::size_t v) { return v >= k ? v - k : winner[v]; };
+    for (std::size_t v = k - 1; v >= 1; --v) {
+        std::size_t left = node_winner(2 * v), right = node_winner(2 * v + 1);
+        bool left_wins = cursors.beats(left, right);
+        winner[v] = left_wins ? left : right;
+        tree[v] = left_wins ? right : left;
+    }
+    std::size_t top = k == 1 ? 0 : winner[1];
+
+    while (cursors.active(top)) {
+        *out = *cursors.pos[top];
+        ++out;
+        ++cursors.pos[top];
+        for (std::size_t v = (top + k) / 2; v >= 1; v /= 2) {
+            if (cursors.beats(tree[v], top)) std::swap(tree[v], top);
+        }
+    }
+    return out;
+}
+
+// k-way merge на двоичной куче номеров серий (для сравнения с kway_merge):
+// те же ядра, что у heap_sort, ~2 log2 k сравнений на элемент
+template<typename Iter, typename OutIter, typename Compare = std::less<>, typename Proj = identity>
+OutIter heap_kway_merge(const std::vector<std::pair<Iter, Iter>>& runs, OutIter out,
+                        Compare comp = {}, Proj proj = {}) {
+    auto cursors = detail::make_merge_cursors(runs, detail::make_less(std::move(comp), std::move(proj)));
+    // Max-куча по "выходит позже": на вершине серия, чей элемент следующий
+    auto later = [&cursors](std::size_t a, std::size_t b) { return cursors.beats(b, a); };
+    auto less = detail::make_less(later, identity{});
+
+    std::vector<std::size_t> heap;
+    heap.reserve(runs.size());
+    for (std::size_t i = 0; i < runs.size(); ++i)
+        if (cursors.active(i)) heap.push_back(i);
+    build_heap(heap.begin(), heap.end(), less);
+
+    std::ptrdiff_t n = static_cast<std::ptrdiff_t>(heap.size());
+    while (n > 0) {
+        std::size_t top = heap[0];
+        *out = *cursors.pos[top];
+        ++out;
+        ++cursors.pos[top];
+        // Исчерпанная серия заменяется последней, иначе вершина просеивается
+        std::size_t value = cursors.active(top) ? top : heap[--n];
+        if (n > 0) detail::sift_down(heap.begin(), n, std::ptrdiff_t(0), value, less);
+    }
+    return out;
+}
+
+} // namespace coursework
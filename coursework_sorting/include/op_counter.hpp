@@ -0,0 +1,69 @@
+// op_counter.hpp
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace coursework {
+
+// Операции над элементами за одну сортировку. swaps - вызовы swap (в т.ч.
+// через std::iter_swap), их перемещения внутри в moves не входят.
+struct OpCounts {
+    std::size_t comparisons = 0;
+    std::size_t copies = 0;
+    std::size_t moves = 0;
+    std::size_t swaps = 0;
+};
+
+// Элемент-обертка, считающая сравнения (operator<, operator>, operator==),
+// копирования, перемещения и обмены. Сортировки - шаблоны по итератору,
+// поэтому сами алгоритмы не меняются и на обычных типах ничего не стоят:
+// счет идет только при сортировке Counted<T>. Счетчики - общие для всех
+// Counted<T> одного T, перед замером их обнуляет reset().
+//
+// Тривиально копируемые T теряют это свойство в обертке: сортировки с
+// отдельным путем для них (memmove в binary_insertion_sort) считаются
+// по общему пути.
+template<typename T>
+struct Counted {
+    T value{};
+
+    inline static OpCounts counts;
+
+    static void reset() { counts = OpCounts{}; }
+
+    Counted() = default;
+    explicit Counted(const T& v) : value(v) {}
+    Counted(const Counted& other) : value(other.value) { ++counts.copies; }
+    Counted(Counted&& other) noexcept : value(std::move(other.value)) { ++counts.moves; }
+    Counted& operator=(const Counted& other) {
+        value = other.value;
+        ++counts.copies;
+        return *this;
+    }
+    Counted& operator=(Counted&& other) noexcept {
+        value = std::move(other.value);
+        ++counts.moves;
+        return *this;
+    }
+
+    friend bool operator<(const Counted& a, const Counted& b) {
+        ++counts.comparisons;
+        return a.value < b.value;
+    }
+    friend bool operator>(const Counted& a, const Counted& b) {
+        ++counts.comparisons;
+        return b.value < a.value;
+    }
+    friend bool operator==(const Counted& a, const Counted& b) {
+        ++counts.comparisons;
+        return a.value == b.value;
+    }
+    friend void swap(Counted& a, Counted& b) noexcept {
+        ++counts.swaps;
+        using std::swap;
+        swap(a.value, b.value);
+    }
+};
+
+} // namespace coursework
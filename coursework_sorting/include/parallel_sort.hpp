@@ -0,0 +1,273 @@
+// parallel_sort.hpp
+#pragma once
+
+#include "algorithms.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace coursework {
+
+namespace detail {
+
+// Ниже этого размера накладные расходы пула больше выигрыша
+constexpr std::size_t parallel_sort_min_size = 1 << 16;
+// Корзин на поток: запас для перехвата работы при неравных корзинах
+constexpr std::size_t buckets_per_thread = 4;
+// Элементов выборки на корзину
+constexpr std::size_t sample_oversampling = 32;
+
+// Номер корзины: число разделителей, не больших x
+template<typename T, typename Iter, typename Less>
+std::size_t find_bucket(const T& x, const std::vector<Iter>& splitters, Less& less) {
+    std::size_t lo = 0, hi = splitters.size();
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (less(x, *splitters[mid])) hi = mid;
+        else lo = mid + 1;
+    }
+    return lo;
+}
+
+} // namespace detail
+
+// Parallel Sort (sample sort) на пуле потоков:
+//   1) выборка по sample_oversampling элементов на корзину (параллельно),
+//      ее сортировка и выбор разделителей;
+//   2) номер корзины каждого элемента и размеры корзин по участкам
+//      массива (параллельно);
+//   3) префиксные суммы и раскладка элементов в буфер по сохраненным
+//      номерам, без повторных сравнений (параллельно);
+//   4) каждая корзина сортируется hybrid_sort (quicksort + heap_sort +
+//      insertion_sort/сети) отдельной задачей и перемещается обратно.
+// Элементы только перемещаются; нужен конструктор по умолчанию для буфера.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void parallel_sort(ThreadPool& pool, Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    const std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    const std::size_t threads = pool.size();
+
+    if (threads == 1 || n < detail::parallel_sort_min_size) {
+        hybrid_sort(begin, end, less);
+        return;
+    }
+
+    // Номер корзины хранится в uint16_t
+    const std::size_t buckets = std::min<std::size_t>(threads * detail::buckets_per_thread, 1 << 16);
+    const std::size_t chunks = threads * detail::buckets_per_thread;
+    const std::size_t chunk_size = (n + chunks - 1) / chunks;
+
+    // 1. Выборка: позиции по мультипликативному хешу, по участку на задачу
+    std::vector<Iter> sample(buckets * detail::sample_oversampling);
+    pool.parallel_for(buckets, [&](std::size_t b) {
+        for (std::size_t k = 0; k < detail::sample_oversampling; ++k) {
+            std::size_t i = b * detail::sample_oversampling + k;
+            std::uint64_t h = (static_cast<std::uint64_t>(i) + 1) * 0x9E3779B97F4A7C15ull;
+            sample[i] = begin + static_cast<std::ptrdiff_t>(h % n);
+        }
+    });
+    auto deref_less = [&less](const Iter& a, const Iter& b) { return less(*a, *b); };
+    hybrid_sort(sample.begin(), sample.end(), deref_less);
+
+    std::vector<Iter> splitters;
+    for (std::size_t b = 1; b < buckets; ++b) splitters.push_back(sample[b * detail::sample_oversampling]);
+
+    // 2. Корзина каждого элемента и размеры корзин на каждом участке:
+    //    counts[chunk * buckets + bucket]
+    std::vector<std::uint16_t> bucket_of(n);
+    std::vector<std::size_t> counts(chunks * buckets, 0);
+    pool.parallel_for(chunks, [&](std::size_t c) {
+        std::size_t from = std::min(n, c * chunk_size), to = std::min(n, from + chunk_size);
+        std::size_t* local = counts.data() + c * buckets;
+        for (std::size_t i = from; i < to; ++i) {
+            std::size_t b = detail::find_bucket(*(begin + static_cast<std::ptrdiff_t>(i)), splitters, less);
+            bucket_of[i] = static_cast<std::uint16_t>(b);
+            ++local[b];
+        }
+    });
+
+    // 3. Смещения: корзины подряд, внутри корзины - участки по порядку
+    std::vector<std::size_t> offsets(chunks * buckets);
+    std::vector<std::size_t> bucket_begin(buckets + 1, 0);
+    std::size_t total = 0;
+    for (std::size_t b = 0; b < buckets; ++b) {
+        bucket_begin[b] = total;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            offsets[c * buckets + b] = total;
+            total += counts[c * buckets + b];
+        }
+    }
+    bucket_begin[buckets] = total;
+
+    // Разделители указывают в исходный массив и после перемещения
+    // элементов недействительны, поэтому раскладка идет по bucket_of
+    std::vector<T> buffer(n);
+    pool.parallel_for(chunks, [&](std::size_t c) {
+        std::size_t from = std::min(n, c * chunk_size), to = std::min(n, from + chunk_size);
+        std::size_t* local = offsets.data() + c * buckets;
+        for (std::size_t i = from; i < to; ++i)
+            buffer[local[bucket_of[i]]++] = std::move(*(begin + static_cast<std::ptrdiff_t>(i)));
+    });
+
+    // 4. Корзины независимы: сортировка и возврат в исходный массив
+    pool.parallel_for(buckets, [&](std::size_t b) {
+        auto first = buffer.begin() + static_cast<std::ptrdiff_t>(bucket_begin[b]);
+        auto last = buffer.begin() + static_cast<std::ptrdiff_t>(bucket_begin[b + 1]);
+        hybrid_sort(first, last, less);
+        std::move(first, last, begin + static_cast<std::ptrdiff_t>(bucket_begin[b]));
+    });
+}
+
+namespace detail {
+
+// Уровень кучи короче этого строится последовательно
+constexpr std::size_t parallel_heap_min_level = 1 << 14;
+
+} // namespace detail
+
+// Параллельное построение двоичной max-кучи: узлы одного уровня - корни
+// непересекающихся поддеревьев, поэтому уровень делится на участки между
+// потоками; уровни обрабатываются снизу вверх (после каждого - барьер
+// parallel_for), верхние уровни короче parallel_heap_min_level
+// достраиваются последовательно. Результат - та же куча, что у build_heap.
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void parallel_build_heap(ThreadPool& pool, Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    using Distance = typename std::iterator_traits<Iter>::difference_type;
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    Distance n = std::distance(begin, end);
+    if (n <= 1) return;
+
+    // Внутренние узлы [0, n / 2); уровень d - узлы [2^d - 1, 2^(d+1) - 1)
+    Distance parents = n / 2;
+    Distance level_begin = 0;
+    while (2 * level_begin + 1 < parents) level_begin = 2 * level_begin + 1;
+
+    const std::size_t chunks = pool.size() * detail::buckets_per_thread;
+    while (level_begin > 0) {
+        Distance level_end = std::min(parents, 2 * level_begin + 1);
+        Distance count = level_end - level_begin;
+        if (pool.size() == 1 || static_cast<std::size_t>(count) < detail::parallel_heap_min_level) break;
+
+        Distance chunk_size = (count + static_cast<Distance>(chunks) - 1) / static_cast<Distance>(chunks);
+        pool.parallel_for(chunks, [&](std::size_t c) {
+            Distance from = std::min(level_end, level_begin + static_cast<Distance>(c) * chunk_size);
+            Distance to = std::min(level_end, from + chunk_size);
+            for (Distance i = from; i < to; ++i)
+                detail::sift_down(begin, n, i, std::move(*(begin + i)), less);
+        });
+        parents = level_begin;
+        level_begin = (level_begin - 1) / 2;
+    }
+
+    // Верхние уровни (и вся куча при одном потоке)
+    for (Distance i = parents; i-- > 0; )
+        detail::sift_down(begin, n, i, std::move(*(begin + i)), less);
+}
+
+// Heap Sort с параллельным построением кучи; извлечение последовательное
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void heap_sort(ThreadPool& pool, Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    auto less = detail::make_less(std::move(comp), std::move(proj));
+    if (std::distance(begin, end) <= 1) return;
+    parallel_build_heap(pool, begin, end, less);
+    extract_heap(begin, end, less);
+}
+
+// Parallel Radix Sort (MSD): старшая 8-битная цифра key - min_key делит
+// массив на 256 корзин (min/max, гистограммы и раскладка - параллельно по
+// участкам), затем каждая корзина сортируется radix_sort<DigitBits>
+// отдельной задачей. Цифра берется от старшего значащего бита диапазона,
+// поэтому узкий диапазон (например, [-1000, 1000]) тоже дает 256 корзин.
+template<std::size_t DigitBits = 8, typename Iter>
+void parallel_radix_sort(ThreadPool& pool, Iter begin, Iter end) {
+    using T = typename std::iterator_traits<Iter>::value_type;
+    using Traits = detail::radix_traits<T>;
+    using Key = typename Traits::Key;
+    constexpr std::size_t top_bits = 8;
+    constexpr std::size_t buckets = std::size_t(1) << top_bits;
+
+    const std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+    if (pool.size() == 1 || n < detail::parallel_sort_min_size) {
+        radix_sort<DigitBits>(begin, end);
+        return;
+    }
+
+    const std::size_t chunks = pool.size() * detail::buckets_per_thread;
+    const std::size_t chunk_size = (n + chunks - 1) / chunks;
+    auto chunk_range = [&](std::size_t c) {
+        std::size_t from = std::min(n, c * chunk_size);
+        return std::make_pair(from, std::min(n, from + chunk_size));
+    };
+
+    // Диапазон ключей: минимум и максимум по участкам
+    std::vector<Key> chunk_min(chunks, static_cast<Key>(~Key(0))), chunk_max(chunks, Key(0));
+    pool.parallel_for(chunks, [&](std::size_t c) {
+        auto range = chunk_range(c);
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            Key k = Traits::key(*(begin + static_cast<std::ptrdiff_t>(i)));
+            if (k < chunk_min[c]) chunk_min[c] = k;
+            if (k > chunk_max[c]) chunk_max[c] = k;
+        }
+    });
+    Key min_key = *std::min_element(chunk_min.begin(), chunk_min.end());
+    Key max_key = *std::max_element(chunk_max.begin(), chunk_max.end());
+    std::size_t width = detail::bit_width(static_cast<Key>(max_key - min_key));
+    if (width == 0) return;
+    const std::size_t shift = width > top_bits ? width - top_bits : 0;
+    auto bucket_of = [&](const T& x) {
+        return static_cast<std::size_t>(static_cast<Key>(Traits::key(x) - min_key) >> shift);
+    };
+
+    // Гистограммы старшей цифры: counts[chunk * buckets + bucket]
+    std::vector<std::size_t> counts(chunks * buckets, 0);
+    pool.parallel_for(chunks, [&](std::size_t c) {
+        auto range = chunk_range(c);
+        std::size_t* local = counts.data() + c * buckets;
+        for (std::size_t i = range.first; i < range.second; ++i)
+            ++local[bucket_of(*(begin + static_cast<std::ptrdiff_t>(i)))];
+    });
+
+    std::vector<std::size_t> offsets(chunks * buckets);
+    std::vector<std::size_t> bucket_begin(buckets + 1, 0);
+    std::size_t total = 0;
+    for (std::size_t b = 0; b < buckets; ++b) {
+        bucket_begin[b] = total;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            offsets[c * buckets + b] = total;
+            total += counts[c * buckets + b];
+        }
+    }
+    bucket_begin[buckets] = total;
+
+    std::vector<T> buffer(n);
+    pool.parallel_for(chunks, [&](std::size_t c) {
+        auto range = chunk_range(c);
+        std::size_t* local = offsets.data() + c * buckets;
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            auto it = begin + static_cast<std::ptrdiff_t>(i);
+            buffer[local[bucket_of(*it)]++] = std::move(*it);
+        }
+    });
+
+    // Корзины: LSD по оставшимся цифрам и возврат в исходный массив
+    pool.parallel_for(buckets, [&](std::size_t b) {
+        auto first = buffer.begin() + static_cast<std::ptrdiff_t>(bucket_begin[b]);
+        auto last = buffer.begin() + static_cast<std::ptrdiff_t>(bucket_begin[b + 1]);
+        radix_sort<DigitBits>(first, last);
+        std::move(first, last, begin + static_cast<std::ptrdiff_t>(bucket_begin[b]));
+    });
+}
+
+// Parallel Sort на общем пуле ThreadPool::global()
+template<typename Iter, typename Compare = std::less<>, typename Proj = identity>
+void parallel_sort(Iter begin, Iter end, Compare comp = {}, Proj proj = {}) {
+    parallel_sort(ThreadPool::global(), begin, end, std::move(comp), std::move(proj));
+}
+
+} // namespace coursework
@@ -0,0 +1,64 @@
+// perf_counters.hpp
+#pragma once
+
+#include <string>
+
+namespace coursework {
+
+// Аппаратные счетчики одного замеряемого участка. Значение -1 - счетчик
+// недоступен (нет PMU, запрет perf_event_paranoid, не Linux); арифметика
+// сохраняет -1. Числа дробные: при мультиплексировании ядро считает часть
+// времени, значения масштабируются на полное время.
+struct CounterValues {
+    double cycles = -1.0;
+    double instructions = -1.0;
+    double l1d_misses = -1.0;     // промахи L1D на чтение
+    double llc_misses = -1.0;     // промахи последнего уровня кэша
+    double branch_misses = -1.0;
+    double dtlb_misses = -1.0;    // промахи dTLB на чтение
+
+    // Инструкций за такт, -1 без cycles/instructions
+    double ipc() const;
+
+    CounterValues& operator+=(const CounterValues& other);
+    CounterValues operator-(const CounterValues& other) const;
+    CounterValues scaled(double factor) const;
+};
+
+// Счетчики вызывающего потока через perf_event_open (только
+// пользовательский режим; работа потоков ThreadPool не учитывается).
+// Каждый счетчик - отдельный fd: недоступные не мешают остальным.
+// Конструктор не бросает исключений: если ничего не открылось, available()
+// == false, status() объясняет причину, а start/read/stop возвращают -1.
+//
+//   PerfCounters counters;
+//   counters.start();
+//   sort(...);
+//   CounterValues values = counters.stop();
+class PerfCounters {
+public:
+    explicit PerfCounters(bool enabled = true);
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return available_; }
+    // Открытые счетчики или причина недоступности
+    const std::string& status() const { return status_; }
+
+    // Обнуляет и включает счетчики
+    void start();
+    // Значения с последнего start(), счетчики продолжают считать
+    CounterValues read() const;
+    // Выключает счетчики и возвращает их значения
+    CounterValues stop();
+
+private:
+    static constexpr int counter_count = 6;
+    int fds_[counter_count] = {-1, -1, -1, -1, -1, -1};
+    bool available_ = false;
+    std::string status_;
+};
+
+} // namespace coursework
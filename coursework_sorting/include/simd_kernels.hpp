@@ -0,0 +1,96 @@
+// simd_kernels.hpp
+#pragma once
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define COURSEWORK_HAS_SSE2 1
+    #include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+    #define COURSEWORK_HAS_AVX2 1
+    #include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace coursework {
+namespace simd {
+
+// Индекс младшего установленного бита (mask != 0)
+inline int lowest_bit(unsigned mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Программная предвыборка строки кэша (на неподдерживаемых платформах - no-op)
+inline void prefetch(const void* p) {
+#if defined(_MSC_VER) && defined(COURSEWORK_HAS_SSE2)
+    _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+#if defined(COURSEWORK_HAS_SSE2)
+// _mm_max_epi32 появляется только в SSE4.1, поэтому эмулируем через сравнение
+inline __m128i max_epi32(__m128i a, __m128i b) {
+    __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+
+inline __m128i hmax_epi32(__m128i v) {
+    v = max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return max_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+#endif
+
+// Позиция максимума среди Width подряд идущих int (первая при равенстве).
+// Используется d-арной кучей для выбора наибольшего ребенка без ветвлений.
+template<std::size_t Width>
+inline std::size_t max_index(const int* p) {
+    std::size_t best = 0;
+    for (std::size_t k = 1; k < Width; ++k)
+        if (p[k] > p[best]) best = k;
+    return best;
+}
+
+#if defined(COURSEWORK_HAS_SSE2)
+template<>
+inline std::size_t max_index<4>(const int* p) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i m = hmax_epi32(v);
+    unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m))));
+    return static_cast<std::size_t>(lowest_bit(mask));
+}
+
+template<>
+inline std::size_t max_index<8>(const int* p) {
+#if defined(COURSEWORK_HAS_AVX2)
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m128i half = _mm_max_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    __m256i m = _mm256_broadcastd_epi32(half);
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m))));
+#else
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4));
+    __m128i m = hmax_epi32(max_epi32(lo, hi));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lo, m))))
+                  | (static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(hi, m)))) << 4);
+#endif
+    return static_cast<std::size_t>(lowest_bit(mask));
+}
+#endif
+
+} // namespace simd
+} // namespace coursework
@@ -0,0 +1,43 @@
+// simd_sort.hpp
+#pragma once
+
+#include <cstddef>
+
+namespace coursework {
+namespace simd {
+
+// Набор инструкций для векторных ядер сортировки; выбирается по CPUID
+// при первом обращении, SCALAR - переносимый запасной путь
+enum class Isa {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+Isa detected_isa();
+Isa active_isa();
+// Ограничить используемый набор (не выше обнаруженного), например для
+// сравнения AVX2 и AVX-512 на одной машине
+void set_active_isa(Isa isa);
+const char* isa_name(Isa isa);
+
+// Наибольший блок, сортируемый целиком в регистрах
+constexpr std::size_t max_block_size = 64;
+
+// Сортировка блока из n <= 64 элементов битонической сетью в регистрах
+// (8/16 элементов в регистре, до 64 в нескольких регистрах)
+void sort_block(int* data, std::size_t n);
+void sort_block(float* data, std::size_t n);
+
+// Слияние двух отсортированных массивов в out векторной битонической сетью
+void merge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out);
+void merge(const float* a, std::size_t na, const float* b, std::size_t nb, float* out);
+
+// SIMD Sort: блоки по 64 в регистрах, затем попарные векторные слияния
+// через буфер размера n. NaN среди float не поддерживаются; -0.0 и +0.0
+// сохраняются, их взаимный порядок не определен.
+void simd_sort(int* first, int* last);
+void simd_sort(float* first, float* last);
+
+} // namespace simd
+} // namespace coursework
@@ -0,0 +1,139 @@
+// sorting_networks.hpp
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+namespace coursework {
+
+namespace detail {
+
+struct comparator_pair {
+    std::size_t first;
+    std::size_t second;
+};
+
+// Число компараторов сети Батчера (odd-even merge sort) для n входов.
+// Для произвольного n алгоритм просто пропускает пары с индексом >= n.
+constexpr std::size_t batcher_size(std::size_t n) {
+    std::size_t count = 0;
+    for (std::size_t p = 1; p < n; p *= 2)
+        for (std::size_t k = p; k >= 1; k /= 2)
+            for (std::size_t j = k % p; j + k < n; j += 2 * k)
+                for (std::size_t i = 0; i < k && i + j + k < n; ++i)
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) ++count;
+    return count;
+}
+
+template<std::size_t N>
+constexpr std::array<comparator_pair, batcher_size(N)> batcher_network() {
+    std::array<comparator_pair, batcher_size(N)> pairs{};
+    std::size_t count = 0;
+    for (std::size_t p = 1; p < N; p *= 2)
+        for (std::size_t k = p; k >= 1; k /= 2)
+            for (std::size_t j = k % p; j + k < N; j += 2 * k)
+                for (std::size_t i = 0; i < k && i + j + k < N; ++i)
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                        pairs[count++] = {i + j, i + j + k};
+    return pairs;
+}
+
+// Оптимальные по числу компараторов сети для N <= 8 (Knuth, TAOCP 5.3.4)
+constexpr std::array<comparator_pair, 1> network2 = {{{0, 1}}};
+constexpr std::array<comparator_pair, 3> network3 = {{{0, 2}, {0, 1}, {1, 2}}};
+constexpr std::array<comparator_pair, 5> network4 = {{{0, 1}, {2, 3}, {0, 2}, {1, 3}, {1, 2}}};
+constexpr std::array<comparator_pair, 9> network5 = {{
+    {0, 3}, {1, 4}, {0, 2}, {1, 3}, {0, 1}, {2, 4}, {1, 2}, {3, 4}, {2, 3}}};
+constexpr std::array<comparator_pair, 12> network6 = {{
+    {0, 5}, {1, 3}, {2, 4}, {1, 2}, {3, 4}, {0, 3}, {2, 5}, {0, 1}, {2, 3}, {4, 5}, {1, 2}, {3, 4}}};
+constexpr std::array<comparator_pair, 16> network7 = {{
+    {0, 6}, {2, 3}, {4, 5}, {0, 2}, {1, 4}, {3, 6}, {0, 1}, {2, 5}, {3, 4},
+    {1, 2}, {4, 6}, {2, 3}, {4, 5}, {1, 2}, {3, 4}, {5, 6}}};
+constexpr std::array<comparator_pair, 19> network8 = {{
+    {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}, {0, 1}, {2, 3},
+    {4, 5}, {6, 7}, {2, 4}, {3, 5}, {1, 4}, {3, 6}, {1, 2}, {3, 4}, {5, 6}}};
+
+template<std::size_t N> struct network_table { static constexpr auto pairs = batcher_network<N>(); };
+template<> struct network_table<2> { static constexpr auto pairs = network2; };
+template<> struct network_table<3> { static constexpr auto pairs = network3; };
+template<> struct network_table<4> { static constexpr auto pairs = network4; };
+template<> struct network_table<5> { static constexpr auto pairs = network5; };
+template<> struct network_table<6> { static constexpr auto pairs = network6; };
+template<> struct network_table<7> { static constexpr auto pairs = network7; };
+template<> struct network_table<8> { static constexpr auto pairs = network8; };
+
+// Компаратор без ветвлений: для тривиально копируемых типов выбор через
+// тернарный оператор компилируется в cmov/min/max
+template<typename T, typename Less>
+inline void compare_exchange(T& a, T& b, Less& less, std::true_type) {
+    bool swap = less(b, a);
+    T lo = swap ? b : a;
+    T hi = swap ? a : b;
+    a = lo;
+    b = hi;
+}
+
+template<typename T, typename Less>
+inline void compare_exchange(T& a, T& b, Less& less, std::false_type) {
+    using std::swap;
+    if (less(b, a)) swap(a, b);
+}
+
+} // namespace detail
+
+// Сортирующая сеть на N элементов: фиксированная последовательность
+// компараторов, развернутая на этапе компиляции
+template<std::size_t N>
+struct sort_network {
+    static constexpr std::size_t size = N;
+
+    template<typename Iter, typename Less>
+    static void apply(Iter first, Less& less) {
+        apply_impl(first, less, std::make_index_sequence<detail::network_table<N>::pairs.size()>{});
+    }
+
+private:
+    template<typename Iter, typename Less, std::size_t... I>
+    static void apply_impl(Iter first, Less& less, std::index_sequence<I...>) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        using Branchless = std::integral_constant<bool, std::is_trivially_copyable<T>::value>;
+        constexpr auto& pairs = detail::network_table<N>::pairs;
+        (void)first;
+        (void)less;
+        (detail::compare_exchange(*(first + pairs[I].first), *(first + pairs[I].second),
+                                  less, Branchless{}), ...);
+    }
+};
+
+template<> struct sort_network<0> {
+    template<typename Iter, typename Less> static void apply(Iter, Less&) {}
+};
+template<> struct sort_network<1> {
+    template<typename Iter, typename Less> static void apply(Iter, Less&) {}
+};
+
+namespace detail {
+
+// Наибольший размер, для которого есть сеть в диспетчере
+constexpr std::size_t max_network_size = 32;
+
+template<typename Iter, typename Less, std::size_t... N>
+void dispatch_network(Iter first, std::size_t n, Less& less, std::index_sequence<N...>) {
+    using Fn = void (*)(Iter, Less&);
+    static constexpr Fn table[] = {&sort_network<N>::template apply<Iter, Less>...};
+    table[n](first, less);
+}
+
+} // namespace detail
+
+// Сортировка [first, first + n) сетью нужного размера, n <= 32
+template<typename Iter, typename Less>
+void sort_with_network(Iter first, std::size_t n, Less& less) {
+    detail::dispatch_network(first, n, less,
+        std::make_index_sequence<detail::max_network_size + 1>{});
+}
+
+} // namespace coursework
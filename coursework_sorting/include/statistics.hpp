@@ -0,0 +1,38 @@
+// statistics.hpp
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace coursework {
+
+// Сводка выборки замеров времени. samples - все замеры в порядке получения;
+// остальные поля считаются по выборке без выбросов (outliers - сколько
+// отброшено). Пустая выборка - все значения -1.
+struct SampleStats {
+    std::vector<double> samples;
+    std::size_t outliers = 0;
+    double mean = -1.0;
+    double median = -1.0;
+    double p5 = -1.0;
+    double p95 = -1.0;
+    double p99 = -1.0;
+    double stdev = -1.0;
+    double mad = -1.0;      // медиана |x - median|, без масштабного множителя
+    double ci_low = -1.0;   // 95% доверительный интервал медианы
+    double ci_high = -1.0;
+
+    // Полуширина доверительного интервала относительно медианы (0.02 = ±2%)
+    double relative_ci() const;
+};
+
+// Квантиль q из [0, 1] отсортированной выборки, линейная интерполяция
+double quantile(const std::vector<double>& sorted, double q);
+
+// reject_outliers: отбрасываются x с |x - median| > 3.5 * 1.4826 * MAD
+// (модифицированный z-score). ДИ медианы - перцентильный bootstrap на
+// resamples повторных выборках с фиксированным зерном, т.е. воспроизводим.
+SampleStats summarize(std::vector<double> samples, bool reject_outliers = true,
+                      std::size_t resamples = 1000);
+
+} // namespace coursework
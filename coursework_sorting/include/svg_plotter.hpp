@@ -20,6 +20,7 @@ private:
         const char* insertion;
         const char* heap;
         const char* stdsort;
+        const char* radix;
         const char* grid;
         const char* axis;
         const char* text;
@@ -43,4 +44,4 @@ public:
     static bool create_all_svg_plots(const std::string& csv_filename);
 };
 
-} // namespace coursework
\ No newline at end of file
+} // namespace coursework
\ No newline at end of file
@@ -0,0 +1,72 @@
+// thread_pool.hpp
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coursework {
+
+// Пул потоков с перехватом работы (work stealing): задачи parallel_for
+// раскладываются по очередям потоков, свободный поток забирает задачи
+// из хвоста своей очереди, а опустевший - из головы чужой.
+// Вызывающий поток тоже выполняет задачи, поэтому threads = 1 означает
+// последовательное выполнение без дополнительных потоков.
+class ThreadPool {
+public:
+    // threads = 0 - по числу аппаратных потоков
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return queues_.size(); }
+
+    // f(0), ..., f(count - 1) на потоках пула; возвращается после
+    // завершения всех задач. Вложенный вызов из задачи выполняется
+    // последовательно в текущем потоке. Если f бросает исключение,
+    // оставшиеся задачи пропускаются, а первое исключение пробрасывается
+    // вызывающему после завершения уже начатых задач.
+    void parallel_for(std::size_t count, const std::function<void(std::size_t)>& f);
+
+    // Общий пул для parallel_sort без явного пула
+    static ThreadPool& global();
+    // Пересоздать общий пул с заданным числом потоков (0 - по числу ядер).
+    // Старый пул уничтожается: ссылки, полученные от global(), становятся
+    // недействительными, поэтому вызывать только пока общий пул не используется.
+    static void set_global_threads(std::size_t threads);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> items;
+    };
+
+    void worker_loop(std::size_t id);
+    void run_tasks(std::size_t id);
+    bool pop(std::size_t id, std::size_t& item);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex run_mutex_;  // один parallel_for за раз
+    std::mutex state_mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(std::size_t)>* task_ = nullptr;
+    std::atomic<std::size_t> remaining_{0};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;  // первое исключение задачи, под state_mutex_
+    std::size_t generation_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace coursework
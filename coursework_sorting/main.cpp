@@ -9,6 +9,17 @@
 int main() {
     try {
         coursework::Benchmark benchmark;
+        // Медианы с прогревом; замеры продолжаются до ДИ медианы +-3%,
+        // аппаратные счетчики - если их дает ядро; малые массивы замеряются
+        // пакетами не короче 100 мкс по TSC
+        coursework::MeasurementOptions measurement;
+        measurement.warmup_runs = 2;
+        measurement.target_ci = 0.03;
+        measurement.max_samples = 200;
+        measurement.hardware_counters = true;
+        measurement.min_batch_us = 100.0;
+        measurement.cycle_clock = true;
+        benchmark.set_measurement(measurement);
 
         std::cout << "========================================\n";
         std::cout << "   COMPARISON OF SORTING ALGORITHMS    \n";
@@ -35,6 +46,10 @@ int main() {
         std::cout << "Insertion Sort: " << sorted_test.insertion_sort_time << " us\n";
         std::cout << "Heap Sort:      " << sorted_test.heap_sort_time << " us\n";
         std::cout << "std::sort:      " << sorted_test.std_sort_time << " us\n";
+        std::cout << "Hybrid Sort:    " << sorted_test.hybrid_sort_time << " us\n";
+        std::cout << "SIMD Sort:      " << sorted_test.simd_sort_time << " us\n";
+        std::cout << "Adaptive Sort:  " << sorted_test.adaptive_sort_time << " us"
+                  << " (natural runs: " << sorted_test.natural_runs << ")\n";
 
         std::cout << "\n4. REVERSED DATA TEST\n";
         std::cout << "======================\n";
@@ -43,6 +58,46 @@ int main() {
         std::cout << "Insertion Sort: " << reversed_test.insertion_sort_time << " us\n";
         std::cout << "Heap Sort:      " << reversed_test.heap_sort_time << " us\n";
         std::cout << "std::sort:      " << reversed_test.std_sort_time << " us\n";
+        std::cout << "Hybrid Sort:    " << reversed_test.hybrid_sort_time << " us\n";
+        std::cout << "SIMD Sort:      " << reversed_test.simd_sort_time << " us\n";
+        std::cout << "Adaptive Sort:  " << reversed_test.adaptive_sort_time << " us"
+                  << " (natural runs: " << reversed_test.natural_runs << ")\n";
+
+        std::cout << "\n5. HEAVY ELEMENTS TEST\n";
+        std::cout << "=======================\n";
+        auto payload_results = benchmark.run_payload_test(1000, 5, coursework::DataType::RANDOM);
+        benchmark.print_payload_results(payload_results);
+
+        std::cout << "\n6. SMALL ARRAYS TEST\n";
+        std::cout << "=====================\n";
+        auto small_results = benchmark.run_small_array_test(
+            {2, 3, 4, 5, 6, 7, 8, 12, 16, 24, 32, 48, 64, 100}, 5);
+        benchmark.print_small_array_results(small_results);
+
+        std::cout << "\n7. HIGH-DUPLICATE INPUTS TEST\n";
+        std::cout << "==============================\n";
+        // 2001 - диапазон generate(RANDOM): ~50 копий каждого значения
+        auto duplicates_results = benchmark.run_duplicates_test(100000, 5, {2, 16, 256, 2001, 1000000});
+        benchmark.print_duplicates_results(duplicates_results);
+
+        std::cout << "\n8. PRIORITY QUEUE TEST\n";
+        std::cout << "======================\n";
+        auto queue_results = benchmark.run_priority_queue_test({1000, 100000, 1000000}, 2000000);
+        benchmark.print_priority_queue_results(queue_results);
+
+        std::cout << "\n9. K-WAY MERGE TEST\n";
+        std::cout << "===================\n";
+        auto merge_results = benchmark.run_kway_merge_test({2, 4, 16, 64, 256, 1024, 4096}, {64, 4096});
+        benchmark.print_kway_merge_results(merge_results);
+
+        std::cout << "\n10. OPERATION COUNTS\n";
+        std::cout << "====================\n";
+        auto op_results = benchmark.run_operation_count_test(
+            {100, 1000, 10000},
+            {coursework::DataType::RANDOM, coursework::DataType::SORTED,
+             coursework::DataType::REVERSED, coursework::DataType::ALMOST_SORTED});
+        benchmark.print_operation_count_results(op_results);
+        benchmark.save_operation_counts_to_csv(op_results, "operation_counts.csv");
 
         std::cout << "\n" << std::string(50, '=') << "\n";
         std::cout << "ALL TESTS COMPLETED SUCCESSFULLY!\n";
@@ -62,4 +117,4 @@ int main() {
         
         return 1;
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "algorithms.hpp"
+#include "mapped_file.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// mmap_sort - сортировка двоичного файла ключей на месте через mmap:
+// файл не копируется в std::vector, страницы подгружает ядро по мере
+// обращения алгоритма к ним.
+//
+//   mmap_sort <file> [--type int32|int64|float] [--algorithm NAME]
+//             [--advice none|normal|sequential|random|willneed]
+//             [--evict] [--no-sync] [--verify]
+//   mmap_sort --generate <file> <count> [--type int32|int64|float]
+//
+// NAME: heap (по умолчанию), bottom-up, heap4, prefetch, hybrid, std, radix.
+// Все, кроме radix, сортируют на месте с O(1) (hybrid/std - O(log n))
+// дополнительной памяти; radix берет буфер размером с файл.
+// --evict сбрасывает файл из page cache перед отображением: major faults
+// тогда показывают реальное чтение с диска.
+
+namespace {
+
+struct Options {
+    std::string path;
+    std::string type = "int32";
+    std::string algorithm = "heap";
+    coursework::MapAdvice advice = coursework::MapAdvice::NONE;
+    bool evict = false;
+    bool sync = true;
+    bool verify = false;
+};
+
+void print_usage() {
+    std::cout << "Usage:\n"
+              << "  mmap_sort <file> [--type int32|int64|float] [--algorithm NAME]\n"
+              << "            [--advice none|normal|sequential|random|willneed]\n"
+              << "            [--evict] [--no-sync] [--verify]\n"
+              << "  mmap_sort --generate <file> <count> [--type int32|int64|float]\n"
+              << "NAME: heap, bottom-up, heap4, prefetch, hybrid, std, radix\n";
+}
+
+coursework::MapAdvice parse_advice(const std::string& name) {
+    if (name == "none") return coursework::MapAdvice::NONE;
+    if (name == "normal") return coursework::MapAdvice::NORMAL;
+    if (name == "sequential") return coursework::MapAdvice::SEQUENTIAL;
+    if (name == "random") return coursework::MapAdvice::RANDOM;
+    if (name == "willneed") return coursework::MapAdvice::WILLNEED;
+    throw std::runtime_error("Unknown advice " + name);
+}
+
+template<typename T>
+std::function<void(T*, T*)> select_sort(const std::string& name) {
+    if (name == "heap") return [](T* b, T* e) { coursework::heap_sort(b, e); };
+    if (name == "bottom-up") return [](T* b, T* e) { coursework::bottom_up_heap_sort(b, e); };
+    if (name == "heap4") return [](T* b, T* e) { coursework::heap_sort<4>(b, e); };
+    if (name == "prefetch") return [](T* b, T* e) { coursework::prefetch_heap_sort(b, e); };
+    if (name == "hybrid") return [](T* b, T* e) { coursework::hybrid_sort(b, e); };
+    if (name == "std") return [](T* b, T* e) { std::sort(b, e); };
+    if (name == "radix") return [](T* b, T* e) { coursework::radix_sort(b, e); };
+    throw std::runtime_error("Unknown algorithm " + name);
+}
+
+// Случайные ключи типа T порциями по 1M, без загрузки файла в память
+template<typename T>
+void generate_file(const std::string& path, std::uint64_t count) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("Cannot create file " + path);
+    std::mt19937_64 rng(std::random_device{}());
+    std::vector<T> chunk;
+    for (std::uint64_t done = 0; done < count; done += chunk.size()) {
+        chunk.resize(static_cast<std::size_t>(std::min<std::uint64_t>(count - done, 1 << 20)));
+        for (auto& x : chunk) {
+            if constexpr (std::is_floating_point<T>::value) {
+                x = std::uniform_real_distribution<T>(-1e6, 1e6)(rng);
+            } else {
+                x = static_cast<T>(rng());
+            }
+        }
+        if (std::fwrite(chunk.data(), sizeof(T), chunk.size(), file) != chunk.size()) {
+            std::fclose(file);
+            throw std::runtime_error("Cannot write file " + path);
+        }
+    }
+    if (std::fclose(file) != 0) throw std::runtime_error("Cannot write file " + path);
+}
+
+double seconds_since(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void print_phase(const char* name, double seconds, const coursework::PageFaults& before,
+                 const coursework::PageFaults& after) {
+    std::cout << std::left << std::setw(10) << name
+              << std::right << std::setw(12) << seconds * 1000.0 << " ms"
+              << std::setw(14) << after.minor - before.minor
+              << std::setw(14) << after.major - before.major << "\n";
+}
+
+template<typename T>
+int sort_file(const Options& options) {
+    auto sort = select_sort<T>(options.algorithm);
+    if (options.evict) coursework::evict_from_page_cache(options.path);
+
+    auto faults_start = coursework::page_faults();
+    auto start = std::chrono::high_resolution_clock::now();
+    coursework::MappedFile file(options.path);
+    if (file.size() % sizeof(T) != 0) {
+        throw std::runtime_error("File size is not a multiple of the key size");
+    }
+    file.advise(options.advice);
+    double map_seconds = seconds_since(start);
+    auto faults_mapped = coursework::page_faults();
+
+    T* first = static_cast<T*>(file.data());
+    T* last = first + file.size() / sizeof(T);
+    start = std::chrono::high_resolution_clock::now();
+    sort(first, last);
+    double sort_seconds = seconds_since(start);
+    auto faults_sorted = coursework::page_faults();
+
+    double sync_seconds = 0.0;
+    if (options.sync) {
+        start = std::chrono::high_resolution_clock::now();
+        file.sync();
+        sync_seconds = seconds_since(start);
+    }
+    auto faults_synced = coursework::page_faults();
+
+    double mb = file.size() / (1024.0 * 1024.0);
+    double total = map_seconds + sort_seconds + sync_seconds;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "File:      " << options.path << " (" << last - first << " x " << options.type
+              << ", " << mb << " MB)\n";
+    std::cout << "Algorithm: " << options.algorithm << ", advice: " << coursework::advice_name(options.advice)
+              << (options.evict ? ", evicted from page cache" : "") << "\n\n";
+    std::cout << std::left << std::setw(10) << "Phase" << std::right << std::setw(15) << "Time"
+              << std::setw(14) << "Minor faults" << std::setw(14) << "Major faults" << "\n";
+    print_phase("map", map_seconds, faults_start, faults_mapped);
+    print_phase("sort", sort_seconds, faults_mapped, faults_sorted);
+    if (options.sync) print_phase("msync", sync_seconds, faults_sorted, faults_synced);
+    print_phase("total", total, faults_start, faults_synced);
+    std::cout << "\nThroughput: " << mb / total << " MB/s\n";
+
+    if (options.verify) {
+        bool sorted = std::is_sorted(first, last);
+        std::cout << "Sorted:     " << (sorted ? "yes" : "NO") << "\n";
+        if (!sorted) return 1;
+    }
+    return 0;
+}
+
+template<typename T>
+int run(const Options& options, bool generate, std::uint64_t count) {
+    if (generate) {
+        generate_file<T>(options.path, count);
+        return 0;
+    }
+    return sort_file<T>(options);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            print_usage();
+            return 1;
+        }
+        Options options;
+        std::string first = argv[1];
+        bool generate = first == "--generate";
+        std::uint64_t count = 0;
+        int i = 1;
+        if (generate) {
+            if (argc < 4) {
+                print_usage();
+                return 1;
+            }
+            options.path = argv[2];
+            count = std::stoull(argv[3]);
+            i = 4;
+        } else {
+            options.path = first;
+            i = 2;
+        }
+
+        for (; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if (arg == "--type" && has_value) options.type = argv[++i];
+            else if (arg == "--algorithm" && has_value) options.algorithm = argv[++i];
+            else if (arg == "--advice" && has_value) options.advice = parse_advice(argv[++i]);
+            else if (arg == "--evict") options.evict = true;
+            else if (arg == "--no-sync") options.sync = false;
+            else if (arg == "--verify") options.verify = true;
+            else {
+                print_usage();
+                return 1;
+            }
+        }
+
+        if (options.type == "int32") return run<std::int32_t>(options, generate, count);
+        if (options.type == "int64") return run<std::int64_t>(options, generate, count);
+        if (options.type == "float") return run<float>(options, generate, count);
+        print_usage();
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
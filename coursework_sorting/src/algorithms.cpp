@@ -1,7 +1,75 @@
 #include "algorithms.hpp"
+#include "parallel_sort.hpp"
+#include "generators.hpp"
+#include <string>
 
 // Явные инстанциации для часто используемых типов
 template void coursework::insertion_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::heap_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::bottom_up_heap_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::heap_sort<4, std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::heap_sort<8, std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::prefetch_heap_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::heap_select<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::partial_heap_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::binary_insertion_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::hybrid_sort<16, std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::parallel_sort<std::vector<int>::iterator>(
+    coursework::ThreadPool&, std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::radix_sort<8, std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator);
+template void coursework::radix_sort<11, std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator);
+template void coursework::radix_sort<16, std::vector<int>::iterator>(
     std::vector<int>::iterator, std::vector<int>::iterator);
+template void coursework::three_way_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::counting_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator);
+template void coursework::cardinality_aware_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::adaptive_sort<std::vector<int>::iterator>(
+    std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::parallel_radix_sort<8, std::vector<int>::iterator>(
+    coursework::ThreadPool&, std::vector<int>::iterator, std::vector<int>::iterator);
 template void coursework::heap_sort<std::vector<int>::iterator>(
-    std::vector<int>::iterator, std::vector<int>::iterator);
\ No newline at end of file
+    coursework::ThreadPool&, std::vector<int>::iterator, std::vector<int>::iterator,
+    std::less<>, coursework::identity);
+
+// Тяжелые элементы: сортировки только перемещают их, без копий
+template void coursework::insertion_sort<std::vector<std::string>::iterator>(
+    std::vector<std::string>::iterator, std::vector<std::string>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::heap_sort<std::vector<std::string>::iterator>(
+    std::vector<std::string>::iterator, std::vector<std::string>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::insertion_sort<std::vector<coursework::Record>::iterator>(
+    std::vector<coursework::Record>::iterator, std::vector<coursework::Record>::iterator,
+    std::less<>, coursework::identity);
+template void coursework::heap_sort<std::vector<coursework::Record>::iterator>(
+    std::vector<coursework::Record>::iterator, std::vector<coursework::Record>::iterator,
+    std::less<>, coursework::identity);
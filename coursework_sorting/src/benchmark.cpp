@@ -1,6 +1,14 @@
 #include "benchmark.hpp"
 #include "algorithms.hpp"
 #include "generators.hpp"
+#include "simd_sort.hpp"
+#include "parallel_sort.hpp"
+#include "heap.hpp"
+#include "merge.hpp"
+#include "statistics.hpp"
+#include "perf_counters.hpp"
+#include "op_counter.hpp"
+#include "cycle_clock.hpp"
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
@@ -8,74 +16,652 @@
 #include <chrono>
 #include <stdexcept>
 #include <sstream>  // для std::stringstream
+#include <utility>
+#include <functional>
+#include <queue>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <limits>
+#include <cstdint>
 
 namespace coursework {
 
+namespace {
+
+// Sort вызывается как sort(begin, end, proj); для Counted проекция
+// сначала достает исходный элемент, затем применяет proj
+template<typename T, typename Sort, typename Proj>
+void count_copies(const std::vector<T>& data, Sort sort, Proj proj, size_t& copies, size_t& moves) {
+    std::vector<Counted<T>> tracked;
+    tracked.reserve(data.size());
+    for (const auto& x : data) tracked.emplace_back(x);
+    Counted<T>::reset();
+    sort(tracked.begin(), tracked.end(),
+         [proj](const Counted<T>& t) -> decltype(auto) { return std::invoke(proj, t.value); });
+    copies = Counted<T>::counts.copies;
+    moves = Counted<T>::counts.moves;
+}
+
+// Время сортировки копии data в микросекундах с проверкой порядка
+template<typename T, typename Sort, typename Compare, typename Proj>
+double time_sort(const std::vector<T>& data, Sort sort, Compare comp, Proj proj, const char* name) {
+    std::vector<T> work = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    sort(work.begin(), work.end(), proj);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto less = [&](const T& a, const T& b) { return comp(std::invoke(proj, a), std::invoke(proj, b)); };
+    if (!std::is_sorted(work.begin(), work.end(), less)) {
+        throw std::runtime_error(std::string(name) + " failed");
+    }
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+template<typename T, typename Compare = std::less<>, typename Proj = identity>
+PayloadResult run_payload(const char* element_type, const std::vector<std::vector<T>>& inputs,
+                          Compare comp = {}, Proj proj = {}) {
+    PayloadResult result;
+    result.element_type = element_type;
+    result.array_size = inputs.front().size();
+    result.iterations = inputs.size();
+    bool insertion_enabled = (result.array_size <= 1000);
+
+    auto insertion = [comp](auto b, auto e, auto p) { insertion_sort(b, e, comp, p); };
+    auto heap = [comp](auto b, auto e, auto p) { heap_sort(b, e, comp, p); };
+    // У std::sort нет проекций - оборачиваем в компаратор
+    auto stdsort = [comp](auto b, auto e, auto p) {
+        std::sort(b, e, [&](const auto& x, const auto& y) { return comp(std::invoke(p, x), std::invoke(p, y)); });
+    };
+
+    double total_insertion = 0.0, total_heap = 0.0, total_std = 0.0;
+    for (const auto& data : inputs) {
+        if (insertion_enabled) total_insertion += time_sort(data, insertion, comp, proj, "Insertion sort");
+        total_heap += time_sort(data, heap, comp, proj, "Heap sort");
+        total_std += time_sort(data, stdsort, comp, proj, "std::sort");
+    }
+
+    if (insertion_enabled) {
+        result.insertion_sort_time = total_insertion / inputs.size();
+        count_copies(inputs.front(), insertion, proj, result.insertion_sort_copies, result.insertion_sort_moves);
+    }
+    result.heap_sort_time = total_heap / inputs.size();
+    result.std_sort_time = total_std / inputs.size();
+    count_copies(inputs.front(), heap, proj, result.heap_sort_copies, result.heap_sort_moves);
+    return result;
+}
+
+// Сортирует подряд все куски длины n из копии data; время на один кусок в нс.
+// Один массив из нескольких элементов сортируется быстрее разрешения таймера,
+// поэтому замеряется пачка.
+template<typename Sort>
+double time_small_batch(const std::vector<int>& data, size_t n, Sort sort) {
+    std::vector<int> work = data;
+    size_t arrays = data.size() / n;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t k = 0; k < arrays; ++k) {
+        sort(work.begin() + k * n, work.begin() + (k + 1) * n);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    for (size_t k = 0; k < arrays; ++k) {
+        if (!std::is_sorted(work.begin() + k * n, work.begin() + (k + 1) * n)) {
+            throw std::runtime_error("Small array sort failed");
+        }
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / arrays;
+}
+
+// Операции одной сортировки копии data, с проверкой порядка
+template<typename Sort>
+OpCounts count_operations(const std::vector<int>& data, Sort sort) {
+    std::vector<Counted<int>> counted;
+    counted.reserve(data.size());
+    for (int x : data) counted.emplace_back(x);
+    Counted<int>::reset();
+    sort(counted.begin(), counted.end());
+    OpCounts counts = Counted<int>::counts;
+    if (!std::is_sorted(counted.begin(), counted.end())) {
+        throw std::runtime_error("Counted sort failed");
+    }
+    return counts;
+}
+
+} // namespace
+
+const char* data_type_name(DataType type) {
+    switch (type) {
+        case DataType::SORTED: return "sorted";
+        case DataType::REVERSED: return "reversed";
+        case DataType::ALMOST_SORTED: return "almost-sorted";
+        default: return "random";
+    }
+}
+
 BenchmarkResult Benchmark::run_single_test(size_t array_size, size_t iterations, DataType data_type) {
     ArrayGenerator generator;
     BenchmarkResult result;
     result.array_size = array_size;
-    result.iterations = iterations;
+    result.warmup_runs = measurement_.warmup_runs;
+    result.input_pool = measurement_.input_pool;
 
-    double total_insertion = 0.0;
-    double total_heap = 0.0;
-    double total_std = 0.0;
+    // Замеры каждого алгоритма в микросекундах и сумма счетчиков по ним
+    struct Series {
+        std::vector<double> samples;
+        CounterValues counters;
+    };
+    Series insertion_series;
+    Series heap_series;
+    Series std_series;
+    Series hybrid_series;
+    Series binary_insertion_series;
+    Series simd_series;
+    Series radix_series;
+    Series adaptive_series;
+    Series build_series;
+    Series extract_series;
+    Series parallel_build_series;
+    bool phases_enabled = (heap_variant_ == HeapSortVariant::CLASSIC);
+    ThreadPool& pool = ThreadPool::global();
 
     size_t completed_iterations = 0;
     bool insertion_enabled = (array_size <= 1000);
+    // Бинарный поиск + memmove отодвигают квадратичный рост дальше
+    bool binary_insertion_enabled = (array_size <= 10000);
 
-    for (size_t i = 0; i < iterations; ++i) {
-        std::vector<int> data = generator.generate(array_size, data_type);
-        
-        if (data.size() != array_size) {
-            throw std::runtime_error("Generated data size mismatch");
+    PerfCounters counters(measurement_.hardware_counters);
+    if (measurement_.hardware_counters) {
+        result.counters_available = counters.available();
+        result.counters_status = counters.status();
+    }
+
+    // Часы: TSC при cycle_clock и инвариантном TSC, иначе high_resolution_clock
+    // в наносекундах; tick() - отсчет, micros(a, b) - интервал в мкс
+    bool tsc = measurement_.cycle_clock && cycle_clock::available();
+    double ticks_per_us = tsc ? cycle_clock::ticks_per_ns() * 1000.0 : 1000.0;
+    if (tsc) result.tsc_ticks_per_ns = cycle_clock::ticks_per_ns();
+    auto tick = [tsc]() -> std::uint64_t {
+        if (tsc) return cycle_clock::now();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+    };
+    auto micros = [ticks_per_us](std::uint64_t start, std::uint64_t end) {
+        return static_cast<double>(end - start) / ticks_per_us;
+    };
+
+    // Прогревочные прогоны (i < warmup_runs) выполняют все то же, но не пишут замеры
+    bool recording = false;
+    auto record = [&recording](Series& series, double time, const CounterValues& values) {
+        if (!recording) return;
+        series.samples.push_back(time);
+        if (series.samples.size() == 1) series.counters = values;
+        else series.counters += values;
+    };
+
+    // Правило остановки: все алгоритмы набрали ДИ медианы не шире target_ci
+    size_t check_every = std::max<size_t>(iterations, 1);
+    size_t max_samples = std::max(iterations, measurement_.max_samples);
+    auto precise_enough = [&]() {
+        for (const Series* series : {&insertion_series, &heap_series, &std_series, &hybrid_series,
+                                     &binary_insertion_series, &simd_series, &radix_series, &adaptive_series,
+                                     &build_series, &extract_series, &parallel_build_series}) {
+            if (series->samples.empty()) continue;
+            if (summarize(series->samples, measurement_.reject_outliers).relative_ci() > measurement_.target_ci) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Размер пакета: std::sort одного входа (лучший из 5 прогонов) должен
+    // уложиться в пакет не короче min_batch_us
+    size_t batch = 1;
+    if (measurement_.input_pool && measurement_.min_batch_us > 0.0 && array_size > 0) {
+        std::vector<int> probe = generator.generate(array_size, data_type);
+        double fastest = std::numeric_limits<double>::max();
+        for (int r = 0; r < 5; ++r) {
+            std::vector<int> copy = probe;
+            auto start = tick();
+            std::sort(copy.begin(), copy.end());
+            fastest = std::min(fastest, micros(start, tick()));
+        }
+        double wanted = std::ceil(measurement_.min_batch_us / std::max(fastest, 1e-3));
+        batch = static_cast<size_t>(std::min(wanted, 4096.0));
+        batch = std::max<size_t>(batch, 1);
+    }
+    result.batch_size = batch;
+
+    // Входы: с input_pool - заранее в одном буфере, иначе генерация на каждом
+    // замере. Перед каждой сортировкой рабочие копии восстанавливаются
+    // memcpy в один и тот же заранее затронутый буфер: batch разных входов
+    // подряд. Без пула - новый вектор на каждую сортировку, как раньше.
+    std::optional<InputPool> inputs;
+    if (measurement_.input_pool) {
+        inputs.emplace(generator, array_size, data_type, (measurement_.warmup_runs + max_samples) * batch);
+    }
+    std::vector<int> generated;
+    std::vector<int> work(array_size * batch);
+    size_t current = 0;
+    auto restore = [&]() {
+        if (!inputs) {
+            work = generated;
+            return;
+        }
+        if (array_size == 0) return;
+        for (size_t j = 0; j < batch; ++j) {
+            std::memcpy(work.data() + j * array_size, inputs->input(current * batch + j), array_size * sizeof(int));
+        }
+    };
+    using Iter = std::vector<int>::iterator;
+    auto for_each_copy = [&](auto&& fn) {
+        for (size_t j = 0; j < batch; ++j) {
+            fn(work.begin() + j * array_size, work.begin() + (j + 1) * array_size);
+        }
+    };
+    // Один замер - batch сортировок подряд; время и счетчики - на одну
+    auto timed = [&](Series& series, auto sort) {
+        restore();
+        counters.start();
+        auto start = tick();
+        for_each_copy(sort);
+        auto end = tick();
+        record(series, micros(start, end) / batch, counters.stop().scaled(1.0 / batch));
+    };
+    auto verify = [&](const char* failure) {
+        for_each_copy([failure](Iter b, Iter e) {
+            if (!std::is_sorted(b, e)) throw std::runtime_error(failure);
+        });
+    };
+
+    for (size_t i = 0; ; ++i) {
+        recording = i >= measurement_.warmup_runs;
+        if (recording) {
+            if (completed_iterations >= max_samples) break;
+            if (completed_iterations >= iterations && completed_iterations % check_every == 0 &&
+                (measurement_.target_ci <= 0.0 || precise_enough())) break;
+        }
+
+        current = i;
+        if (!inputs) {
+            generated = generator.generate(array_size, data_type);
+            if (generated.size() != array_size) {
+                throw std::runtime_error("Generated data size mismatch");
+            }
         }
 
         // Insertion Sort
         if (insertion_enabled) {
-            std::vector<int> data1 = data;
-            auto start = std::chrono::high_resolution_clock::now();
-            insertion_sort(data1.begin(), data1.end());
-            auto end = std::chrono::high_resolution_clock::now();
-            total_insertion += std::chrono::duration<double, std::micro>(end - start).count();
-            
-            // Проверка сортировки
-            if (!std::is_sorted(data1.begin(), data1.end())) {
-                throw std::runtime_error("Insertion sort failed");
-            }
+            timed(insertion_series, [](Iter b, Iter e) { insertion_sort(b, e); });
+            verify("Insertion sort failed");
         }
 
-        // Heap Sort
-        std::vector<int> data2 = data;
-        auto start = std::chrono::high_resolution_clock::now();
-        heap_sort(data2.begin(), data2.end());
-        auto end = std::chrono::high_resolution_clock::now();
-        total_heap += std::chrono::duration<double, std::micro>(end - start).count();
-        
-        // Проверка сортировки
-        if (!std::is_sorted(data2.begin(), data2.end())) {
-            throw std::runtime_error("Heap sort failed");
+        // Binary Insertion Sort
+        if (binary_insertion_enabled) {
+            timed(binary_insertion_series, [](Iter b, Iter e) { binary_insertion_sort(b, e); });
+            verify("Binary insertion sort failed");
+        }
+
+        // Heap Sort (вариант задается set_heap_variant); classic замеряется
+        // по фазам: build_heap + extract_heap - то же, что heap_sort
+        if (heap_variant_ == HeapSortVariant::BOTTOM_UP) {
+            timed(heap_series, [](Iter b, Iter e) { bottom_up_heap_sort(b, e); });
+        } else {
+            // Чтение счетчиков между фазами не входит ни в одно время
+            restore();
+            counters.start();
+            auto start = tick();
+            for_each_copy([](Iter b, Iter e) { build_heap(b, e); });
+            auto built = tick();
+            CounterValues built_counters = counters.read();
+            auto extract_start = tick();
+            for_each_copy([](Iter b, Iter e) { extract_heap(b, e); });
+            auto extracted = tick();
+            CounterValues heap_counters = counters.stop();
+            double scale = 1.0 / batch;
+            record(build_series, micros(start, built) * scale, built_counters.scaled(scale));
+            record(extract_series, micros(extract_start, extracted) * scale,
+                   (heap_counters - built_counters).scaled(scale));
+            record(heap_series, (micros(start, built) + micros(extract_start, extracted)) * scale,
+                   heap_counters.scaled(scale));
+        }
+        verify("Heap sort failed");
+
+        // Параллельное построение кучи (только фаза построения)
+        if (phases_enabled) {
+            timed(parallel_build_series, [&pool](Iter b, Iter e) { parallel_build_heap(pool, b, e); });
+            for_each_copy([](Iter b, Iter e) {
+                if (!std::is_heap(b, e)) throw std::runtime_error("Parallel heap build failed");
+            });
         }
 
         // std::sort
-        std::vector<int> data3 = data;
-        start = std::chrono::high_resolution_clock::now();
-        std::sort(data3.begin(), data3.end());
-        end = std::chrono::high_resolution_clock::now();
-        total_std += std::chrono::duration<double, std::micro>(end - start).count();
+        timed(std_series, [](Iter b, Iter e) { std::sort(b, e); });
 
-        completed_iterations++;
-    }
+        // Hybrid Sort (introsort на insertion_sort и heap_sort)
+        timed(hybrid_series, [](Iter b, Iter e) { hybrid_sort(b, e); });
+        verify("Hybrid sort failed");
+
+        // SIMD Sort (битонические блоки в регистрах + векторное слияние)
+        timed(simd_series, [](Iter b, Iter e) {
+            if (b != e) simd::simd_sort(&*b, &*b + (e - b));
+        });
+        verify("SIMD sort failed");
+
+        // Radix Sort (LSD, без сравнений)
+        timed(radix_series, [](Iter b, Iter e) { radix_sort(b, e); });
+        verify("Radix sort failed");
 
-    if (completed_iterations > 0) {
-        result.insertion_sort_time = insertion_enabled ? total_insertion / completed_iterations : -1.0;
-        result.heap_sort_time = total_heap / completed_iterations;
-        result.std_sort_time = total_std / completed_iterations;
+        // Adaptive Sort (естественные серии + слияние с галопом)
+        timed(adaptive_series, [](Iter b, Iter e) { adaptive_sort(b, e); });
+        verify("Adaptive sort failed");
+
+        // Подсчет сравнений вне замеров времени, на первом входе
+        if (i == 0) {
+            std::vector<int> first = inputs
+                ? std::vector<int>(inputs->input(0), inputs->input(0) + array_size) : generated;
+            result.natural_runs = count_runs(first.begin(), first.end());
+            using CountingIter = std::vector<Counted<int>>::iterator;
+            result.heap_sort_comparisons = count_operations(first,
+                [](CountingIter b, CountingIter e) { heap_sort(b, e); }).comparisons;
+            result.bottom_up_heap_sort_comparisons = count_operations(first,
+                [](CountingIter b, CountingIter e) { bottom_up_heap_sort(b, e); }).comparisons;
+        }
+
+        if (recording) completed_iterations++;
     }
+    result.iterations = completed_iterations;
+
+    // Медиана в поле результата, распределение - в timings; пустые
+    // (выключенные) алгоритмы остаются -1
+    auto summarize_into = [&](const char* name, Series& series, double& time) {
+        if (series.samples.empty()) return;
+        TimingStats timing;
+        timing.algorithm = name;
+        timing.counters = series.counters.scaled(1.0 / static_cast<double>(series.samples.size()));
+        timing.stats = summarize(std::move(series.samples), measurement_.reject_outliers);
+        time = timing.stats.median;
+        result.timings.push_back(std::move(timing));
+    };
+    summarize_into("Insertion Sort", insertion_series, result.insertion_sort_time);
+    summarize_into("Binary Insertion", binary_insertion_series, result.binary_insertion_sort_time);
+    summarize_into("Heap Sort", heap_series, result.heap_sort_time);
+    summarize_into("std::sort", std_series, result.std_sort_time);
+    summarize_into("Hybrid Sort", hybrid_series, result.hybrid_sort_time);
+    summarize_into("SIMD Sort", simd_series, result.simd_sort_time);
+    summarize_into("Radix Sort", radix_series, result.radix_sort_time);
+    summarize_into("Adaptive Sort", adaptive_series, result.adaptive_sort_time);
+    summarize_into("Heap Build", build_series, result.heap_build_time);
+    summarize_into("Heap Extract", extract_series, result.heap_extract_time);
+    summarize_into("Parallel Build", parallel_build_series, result.parallel_heap_build_time);
+    if (!result.timings.empty() && phases_enabled) result.heap_build_threads = pool.size();
 
     return result;
 }
 
+std::vector<PayloadResult> Benchmark::run_payload_test(size_t array_size, size_t iterations, DataType data_type) {
+    ArrayGenerator generator;
+    std::vector<std::vector<std::string>> strings;
+    std::vector<std::vector<Record>> records;
+    for (size_t i = 0; i < std::max<size_t>(iterations, 1); ++i) {
+        strings.push_back(generator.generate_strings(array_size, data_type));
+        records.push_back(generator.generate_records(array_size, data_type));
+    }
+
+    std::vector<PayloadResult> results;
+    results.push_back(run_payload("std::string", strings));
+    results.push_back(run_payload("Record (64 B)", records));
+    // Сортировка записей по полю-ключу через проекцию, по возрастанию и убыванию
+    results.push_back(run_payload("Record .key asc", records, std::less<>{}, &Record::key));
+    results.push_back(run_payload("Record .key desc", records, std::greater<>{}, &Record::key));
+    return results;
+}
+
+std::vector<SmallArrayResult> Benchmark::run_small_array_test(const std::vector<size_t>& sizes, size_t repeats) {
+    const size_t batch_elements = 1 << 16;
+    ArrayGenerator generator;
+    std::vector<SmallArrayResult> results;
+
+    for (size_t size : sizes) {
+        SmallArrayResult result;
+        result.array_size = size;
+        result.arrays = batch_elements / size;
+
+        double total_insertion = 0.0, total_small = 0.0, total_std = 0.0, total_simd = 0.0;
+        bool simd_enabled = (size <= simd::max_block_size);
+        for (size_t r = 0; r < repeats; ++r) {
+            std::vector<int> data = generator.generate(result.arrays * size, DataType::RANDOM);
+            using It = std::vector<int>::iterator;
+            total_insertion += time_small_batch(data, size, [](It b, It e) { insertion_sort(b, e); });
+            total_small += time_small_batch(data, size, [](It b, It e) { small_sort(b, e); });
+            total_std += time_small_batch(data, size, [](It b, It e) { std::sort(b, e); });
+            if (simd_enabled) {
+                total_simd += time_small_batch(data, size, [](It b, It e) {
+                    simd::sort_block(&*b, static_cast<size_t>(e - b));
+                });
+            }
+        }
+
+        result.insertion_sort_ns = total_insertion / repeats;
+        result.small_sort_ns = total_small / repeats;
+        result.std_sort_ns = total_std / repeats;
+        result.simd_block_ns = simd_enabled ? total_simd / repeats : -1.0;
+        results.push_back(result);
+    }
+    return results;
+}
+
+std::vector<DuplicatesResult> Benchmark::run_duplicates_test(size_t array_size, size_t iterations,
+                                                             const std::vector<int>& distinct_counts) {
+    ArrayGenerator generator;
+    std::vector<DuplicatesResult> results;
+
+    for (int distinct : distinct_counts) {
+        DuplicatesResult result;
+        result.array_size = array_size;
+        result.distinct_values = distinct;
+        result.iterations = iterations;
+
+        double total_heap = 0.0, total_std = 0.0, total_three_way = 0.0, total_cardinality = 0.0;
+        for (size_t i = 0; i < iterations; ++i) {
+            std::vector<int> data = generator.generate_few_unique(array_size, distinct);
+            if (i == 0) result.strategy = strategy_name(choose_sort_strategy(data.begin(), data.end()));
+
+            using It = std::vector<int>::iterator;
+            total_heap += time_sort(data, [](It b, It e, identity) { heap_sort(b, e); },
+                                    std::less<>{}, identity{}, "Heap sort");
+            total_std += time_sort(data, [](It b, It e, identity) { std::sort(b, e); },
+                                   std::less<>{}, identity{}, "std::sort");
+            total_three_way += time_sort(data, [](It b, It e, identity) { three_way_sort(b, e); },
+                                         std::less<>{}, identity{}, "3-way sort");
+            total_cardinality += time_sort(data, [](It b, It e, identity) { cardinality_aware_sort(b, e); },
+                                           std::less<>{}, identity{}, "Cardinality-aware sort");
+        }
+
+        result.heap_sort_time = total_heap / iterations;
+        result.std_sort_time = total_std / iterations;
+        result.three_way_sort_time = total_three_way / iterations;
+        result.cardinality_sort_time = total_cardinality / iterations;
+        results.push_back(result);
+    }
+    return results;
+}
+
+namespace {
+
+// Сумма снятых вершин: не дает компилятору выбросить работу очереди
+volatile long long queue_sink = 0;
+
+// Операций в секунду (млн) для очереди queue: push_flags[i] != 0 - push
+// values[i], иначе pop (при пустой очереди - push)
+template<typename Queue>
+double mixed_queue_mops(Queue queue, const std::vector<int>& values,
+                        const std::vector<int>& push_flags, long long& sink) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (push_flags[i] != 0 || queue.empty()) {
+            queue.push(values[i]);
+        } else {
+            sink += queue.top();
+            queue.pop();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return values.size() / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// Модель hold (очередь событий): снятая вершина возвращается с ключом,
+// уменьшенным на increments[i] >= 0
+double hold_queue_mops(std::priority_queue<int> queue, const std::vector<int>& increments, long long& sink) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int increment : increments) {
+        int top = queue.top();
+        sink += top;
+        queue.pop();
+        queue.push(top - increment);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return increments.size() / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+template<std::size_t Arity>
+double hold_queue_mops(Heap<int, std::less<>, Arity> queue, const std::vector<int>& increments, long long& sink) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int increment : increments) sink += queue.pop_push(queue.top() - increment);
+    auto end = std::chrono::high_resolution_clock::now();
+    return increments.size() / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+} // namespace
+
+std::vector<PriorityQueueResult> Benchmark::run_priority_queue_test(const std::vector<size_t>& heap_sizes,
+                                                                     size_t operations) {
+    ArrayGenerator generator;
+    std::vector<PriorityQueueResult> results;
+    long long sink = 0;
+
+    for (size_t heap_size : heap_sizes) {
+        std::vector<int> initial = generator.generate_few_unique(heap_size, 1000000);
+        std::vector<int> values = generator.generate_few_unique(operations, 1000000);
+        // Значения -1 и 0: push и pop поровну
+        std::vector<int> push_flags = generator.generate_few_unique(operations, 2);
+        std::vector<int> increments = values;
+        for (int& increment : increments) increment += 500000;  // [0, 10^6)
+
+        std::priority_queue<int> std_queue(std::less<int>{}, initial);
+        Heap<int, std::less<>, 2> heap2(initial.begin(), initial.end());
+        Heap<int, std::less<>, 4> heap4(initial.begin(), initial.end());
+
+        PriorityQueueResult mixed;
+        mixed.heap_size = heap_size;
+        mixed.operations = operations;
+        mixed.workload = "mixed";
+        mixed.std_queue_mops = mixed_queue_mops(std_queue, values, push_flags, sink);
+        mixed.heap2_mops = mixed_queue_mops(heap2, values, push_flags, sink);
+        mixed.heap4_mops = mixed_queue_mops(heap4, values, push_flags, sink);
+        results.push_back(mixed);
+
+        if (heap_size == 0) continue;
+        PriorityQueueResult hold;
+        hold.heap_size = heap_size;
+        hold.operations = operations;
+        hold.workload = "hold";
+        hold.std_queue_mops = hold_queue_mops(std_queue, increments, sink);
+        hold.heap2_mops = hold_queue_mops(heap2, increments, sink);
+        hold.heap4_mops = hold_queue_mops(heap4, increments, sink);
+        results.push_back(hold);
+    }
+
+    queue_sink = sink;
+    return results;
+}
+
+std::vector<KwayMergeResult> Benchmark::run_kway_merge_test(const std::vector<size_t>& run_counts,
+                                                             const std::vector<size_t>& run_lengths) {
+    ArrayGenerator generator;
+    std::vector<KwayMergeResult> results;
+    using It = std::vector<int>::const_iterator;
+
+    for (size_t run_length : run_lengths) {
+        for (size_t k : run_counts) {
+            size_t total = k * run_length;
+            std::vector<int> data = generator.generate_few_unique(total, 1000000);
+            std::vector<std::pair<It, It>> runs;
+            for (size_t i = 0; i < k; ++i) {
+                std::sort(data.begin() + i * run_length, data.begin() + (i + 1) * run_length);
+                runs.push_back({data.cbegin() + i * run_length, data.cbegin() + (i + 1) * run_length});
+            }
+            std::vector<int> out(total);
+
+            KwayMergeResult result;
+            result.runs = k;
+            result.run_length = run_length;
+            // Не меньше ~4M выходных элементов на замер
+            result.iterations = std::max<size_t>(1, (size_t(1) << 22) / total);
+
+            auto time_merge = [&](auto merge) {
+                auto start = std::chrono::high_resolution_clock::now();
+                for (size_t i = 0; i < result.iterations; ++i) merge(runs, out.begin());
+                auto end = std::chrono::high_resolution_clock::now();
+                if (!std::is_sorted(out.begin(), out.end())) {
+                    throw std::runtime_error("k-way merge failed");
+                }
+                return std::chrono::duration<double, std::nano>(end - start).count() / (result.iterations * total);
+            };
+            result.loser_tree_ns = time_merge([](const auto& r, auto o) { kway_merge(r, o); });
+            result.heap_ns = time_merge([](const auto& r, auto o) { heap_kway_merge(r, o); });
+
+            size_t comparisons = 0;
+            auto counting_less = [&comparisons](int a, int b) { ++comparisons; return a < b; };
+            kway_merge(runs, out.begin(), counting_less);
+            result.loser_tree_comparisons = static_cast<double>(comparisons) / total;
+            comparisons = 0;
+            heap_kway_merge(runs, out.begin(), counting_less);
+            result.heap_comparisons = static_cast<double>(comparisons) / total;
+
+            results.push_back(result);
+        }
+    }
+    return results;
+}
+
+std::vector<OperationCountResult> Benchmark::run_operation_count_test(const std::vector<size_t>& sizes,
+                                                                     const std::vector<DataType>& data_types) {
+    using Iter = std::vector<Counted<int>>::iterator;
+    struct Entry {
+        const char* name;
+        size_t max_size;  // квадратичные - только до 10^4
+        std::function<void(Iter, Iter)> sort;
+    };
+    const size_t unlimited = static_cast<size_t>(-1);
+    const std::vector<Entry> entries = {
+        {"Insertion Sort", 10000, [](Iter b, Iter e) { insertion_sort(b, e); }},
+        {"Binary Insertion", 10000, [](Iter b, Iter e) { binary_insertion_sort(b, e); }},
+        {"Heap Sort", unlimited, [](Iter b, Iter e) { heap_sort(b, e); }},
+        {"Bottom-up Heap", unlimited, [](Iter b, Iter e) { bottom_up_heap_sort(b, e); }},
+        {"Heap Sort<4>", unlimited, [](Iter b, Iter e) { heap_sort<4>(b, e); }},
+        {"Hybrid Sort", unlimited, [](Iter b, Iter e) { hybrid_sort(b, e); }},
+        {"Adaptive Sort", unlimited, [](Iter b, Iter e) { adaptive_sort(b, e); }},
+        {"3-way Sort", unlimited, [](Iter b, Iter e) { three_way_sort(b, e); }},
+        {"std::sort", unlimited, [](Iter b, Iter e) { std::sort(b, e); }},
+    };
+
+    ArrayGenerator generator;
+    std::vector<OperationCountResult> results;
+    for (DataType data_type : data_types) {
+        for (size_t size : sizes) {
+            std::vector<int> data = generator.generate(size, data_type);
+            for (const auto& entry : entries) {
+                if (size > entry.max_size) continue;
+                OperationCountResult result;
+                result.algorithm = entry.name;
+                result.data_type = data_type;
+                result.array_size = size;
+                result.counts = count_operations(data, entry.sort);
+                results.push_back(result);
+            }
+        }
+    }
+    return results;
+}
+
 std::vector<BenchmarkResult> Benchmark::run_test_suite(const std::vector<size_t>& sizes, size_t iterations, DataType data_type) {
     std::vector<BenchmarkResult> results;
     std::cout << "\n=== BENCHMARK SUITE START ===\n";
@@ -88,7 +674,12 @@ std::vector<BenchmarkResult> Benchmark::run_test_suite(const std::vector<size_t>
         std::cout << "Testing size: " << size << " (iterations: " << actual_iterations << ")\n";
         
         auto result = run_single_test(size, actual_iterations, data_type);
-        result.iterations = actual_iterations;
+        if (result.iterations != actual_iterations) {
+            std::cout << "  samples recorded: " << result.iterations << "\n";
+        }
+        if (result.batch_size > 1) {
+            std::cout << "  sorts per sample: " << result.batch_size << "\n";
+        }
         results.push_back(result);
     }
 
@@ -113,6 +704,24 @@ std::string format_time(double microseconds) {
     return ss.str();
 }
 
+namespace {
+
+// Медиана одной сортировки в наносекундах и в тиках TSC (-1 без TSC)
+double ns_per_sort(double microseconds) {
+    return microseconds < 0 ? -1.0 : microseconds * 1000.0;
+}
+
+double cycles_per_sort(const BenchmarkResult& res, double microseconds) {
+    if (microseconds < 0 || res.tsc_ticks_per_ns <= 0) return -1.0;
+    return microseconds * 1000.0 * res.tsc_ticks_per_ns;
+}
+
+double per_element_value(double value, size_t n) {
+    return value < 0 || n == 0 ? -1.0 : value / static_cast<double>(n);
+}
+
+} // namespace
+
 void Benchmark::print_results(const std::vector<BenchmarkResult>& results) {
     if (results.empty()) {
         std::cout << "No results.\n";
@@ -124,49 +733,463 @@ void Benchmark::print_results(const std::vector<BenchmarkResult>& results) {
         system("chcp 65001 > nul");  // UTF-8 в Windows
     #endif
 
-    std::cout << std::string(80, '=') << "\n";
-    std::cout << "RESULTS (average time)\n";
-    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::string(136, '=') << "\n";
+    std::cout << "RESULTS (median time; SIMD Sort: " << simd::isa_name(simd::active_isa()) << ")\n";
+    std::cout << std::string(136, '=') << "\n";
     std::cout << std::left << std::setw(10) << "Size"
-              << std::setw(25) << "Insertion Sort"
-              << std::setw(25) << "Heap Sort"
-              << std::setw(25) << "std::sort" << "\n";
-    std::cout << std::string(80, '-') << "\n";
+              << std::setw(18) << "Insertion Sort"
+              << std::setw(18) << "Binary Insertion"
+              << std::setw(18) << "Heap Sort"
+              << std::setw(18) << "std::sort"
+              << std::setw(18) << "Hybrid Sort"
+              << std::setw(18) << "SIMD Sort"
+              << std::setw(18) << "Radix Sort" << "\n";
+    std::cout << std::string(136, '-') << "\n";
 
     for (const auto& res : results) {
         std::string insertion = res.insertion_sort_time >= 0 ? 
             format_time(res.insertion_sort_time) : "skipped";
+        std::string binary_insertion = res.binary_insertion_sort_time >= 0 ?
+            format_time(res.binary_insertion_sort_time) : "skipped";
         
         std::cout << std::left << std::setw(10) << res.array_size
-                  << std::setw(25) << insertion
-                  << std::setw(25) << format_time(res.heap_sort_time)
-                  << std::setw(25) << format_time(res.std_sort_time) << "\n";
+                  << std::setw(18) << insertion
+                  << std::setw(18) << binary_insertion
+                  << std::setw(18) << format_time(res.heap_sort_time)
+                  << std::setw(18) << format_time(res.std_sort_time)
+                  << std::setw(18) << format_time(res.hybrid_sort_time)
+                  << std::setw(18) << format_time(res.simd_sort_time)
+                  << std::setw(18) << format_time(res.radix_sort_time) << "\n";
     }
-    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::string(136, '=') << "\n";
     
     // Добавляем таблицу сравнения производительности
     std::cout << "\nPERFORMANCE COMPARISON (Heap vs Insertion):\n";
-    std::cout << std::string(60, '-') << "\n";
+    std::cout << std::string(110, '-') << "\n";
     std::cout << std::left << std::setw(10) << "Size"
               << std::setw(20) << "Insertion/Heap"
-              << std::setw(20) << "Heap/std::sort" << "\n";
-    std::cout << std::string(60, '-') << "\n";
+              << std::setw(20) << "Heap/std::sort"
+              << std::setw(20) << "Hybrid/std::sort"
+              << std::setw(20) << "SIMD/std::sort"
+              << std::setw(20) << "Radix/std::sort" << "\n";
+    std::cout << std::string(110, '-') << "\n";
     
     for (const auto& res : results) {
-        if (res.insertion_sort_time > 0 && res.heap_sort_time > 0) {
-            double insertion_vs_heap = res.insertion_sort_time / res.heap_sort_time;
+        if (res.heap_sort_time > 0) {
             double heap_vs_std = res.heap_sort_time / res.std_sort_time;
+            double hybrid_vs_std = res.hybrid_sort_time / res.std_sort_time;
+            double simd_vs_std = res.simd_sort_time / res.std_sort_time;
+            double radix_vs_std = res.radix_sort_time / res.std_sort_time;
             
-            std::stringstream ss1, ss2;
-            ss1 << std::fixed << std::setprecision(2) << insertion_vs_heap << "x";
+            std::stringstream ss1, ss2, ss3, ss4, ss5;
+            if (res.insertion_sort_time > 0) {
+                ss1 << std::fixed << std::setprecision(2) << res.insertion_sort_time / res.heap_sort_time << "x";
+            } else {
+                ss1 << "N/A";
+            }
             ss2 << std::fixed << std::setprecision(2) << heap_vs_std << "x";
+            ss3 << std::fixed << std::setprecision(2) << hybrid_vs_std << "x";
+            ss4 << std::fixed << std::setprecision(2) << simd_vs_std << "x";
+            ss5 << std::fixed << std::setprecision(2) << radix_vs_std << "x";
             
             std::cout << std::left << std::setw(10) << res.array_size
                       << std::setw(20) << ss1.str()
-                      << std::setw(20) << ss2.str() << "\n";
+                      << std::setw(20) << ss2.str()
+                      << std::setw(20) << ss3.str()
+                      << std::setw(20) << ss4.str()
+                      << std::setw(20) << ss5.str() << "\n";
         }
     }
+    std::cout << std::string(110, '=') << "\n";
+
+    if (results.front().heap_build_time >= 0) {
+        std::cout << "\nHEAP SORT PHASES (build vs extraction; parallel build on "
+                  << results.front().heap_build_threads << " threads):\n";
+        std::cout << std::string(82, '-') << "\n";
+        std::cout << std::left << std::setw(10) << "Size"
+                  << std::setw(16) << "Build"
+                  << std::setw(16) << "Extract"
+                  << std::setw(14) << "Build share"
+                  << std::setw(16) << "Parallel build"
+                  << std::setw(10) << "Speedup" << "\n";
+        std::cout << std::string(82, '-') << "\n";
+
+        for (const auto& res : results) {
+            std::stringstream share, speedup;
+            share << std::fixed << std::setprecision(1)
+                  << 100.0 * res.heap_build_time / (res.heap_build_time + res.heap_extract_time) << "%";
+            speedup << std::fixed << std::setprecision(2)
+                    << res.heap_build_time / res.parallel_heap_build_time << "x";
+            std::cout << std::left << std::setw(10) << res.array_size
+                      << std::setw(16) << format_time(res.heap_build_time)
+                      << std::setw(16) << format_time(res.heap_extract_time)
+                      << std::setw(14) << share.str()
+                      << std::setw(16) << format_time(res.parallel_heap_build_time)
+                      << std::setw(10) << speedup.str() << "\n";
+        }
+        std::cout << std::string(82, '=') << "\n";
+    }
+
+    std::cout << "\nPRESORTEDNESS (natural runs on the first input) AND ADAPTIVE SORT:\n";
+    std::cout << std::string(72, '-') << "\n";
+    std::cout << std::left << std::setw(10) << "Size"
+              << std::setw(10) << "Runs"
+              << std::setw(10) << "Runs/n"
+              << std::setw(16) << "Heap Sort"
+              << std::setw(16) << "Adaptive Sort"
+              << std::setw(10) << "Heap/Adap" << "\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    for (const auto& res : results) {
+        std::stringstream density, ratio;
+        density << std::fixed << std::setprecision(3)
+                << static_cast<double>(res.natural_runs) / static_cast<double>(res.array_size);
+        ratio << std::fixed << std::setprecision(2) << res.heap_sort_time / res.adaptive_sort_time << "x";
+        std::cout << std::left << std::setw(10) << res.array_size
+                  << std::setw(10) << res.natural_runs
+                  << std::setw(10) << density.str()
+                  << std::setw(16) << format_time(res.heap_sort_time)
+                  << std::setw(16) << format_time(res.adaptive_sort_time)
+                  << std::setw(10) << ratio.str() << "\n";
+    }
+    std::cout << std::string(72, '=') << "\n";
+
+    std::cout << "\nCOMPARISONS (Heap Sort vs Bottom-up Heap Sort):\n";
+    std::cout << std::string(60, '-') << "\n";
+    std::cout << std::left << std::setw(10) << "Size"
+              << std::setw(18) << "Heap Sort"
+              << std::setw(18) << "Bottom-up"
+              << std::setw(14) << "Ratio" << "\n";
+    std::cout << std::string(60, '-') << "\n";
+
+    for (const auto& res : results) {
+        if (res.heap_sort_comparisons == 0) continue;
+        std::stringstream ratio;
+        ratio << std::fixed << std::setprecision(2)
+              << static_cast<double>(res.bottom_up_heap_sort_comparisons) / res.heap_sort_comparisons << "x";
+
+        std::cout << std::left << std::setw(10) << res.array_size
+                  << std::setw(18) << res.heap_sort_comparisons
+                  << std::setw(18) << res.bottom_up_heap_sort_comparisons
+                  << std::setw(14) << ratio.str() << "\n";
+    }
     std::cout << std::string(60, '=') << "\n";
+
+    // Время и счетчики на один элемент: сравнимы между размерами
+    auto per_element = [](double value, size_t n) {
+        std::stringstream ss;
+        if (value < 0 || n == 0) ss << "N/A";
+        else ss << std::fixed << std::setprecision(3) << value / static_cast<double>(n);
+        return ss.str();
+    };
+
+    std::cout << "\nTIMING STATISTICS (" << results.front().warmup_runs << " warmup runs; "
+              << (results.front().input_pool ? "pooled inputs" : "inputs generated per sample") << "; "
+              << "Samples = kept/recorded; CI = 95% bootstrap CI of the median;\n"
+              << "Batch = sorts per sample, times are per sort; "
+              << (results.front().tsc_ticks_per_ns > 0 ? "TSC clock" : "high_resolution_clock")
+              << "; cyc/elem = TSC reference cycles, not core cycles):\n";
+    std::cout << std::string(148, '-') << "\n";
+    std::cout << std::left << std::setw(10) << "Size"
+              << std::setw(18) << "Algorithm"
+              << std::setw(10) << "Samples"
+              << std::setw(7) << "Batch"
+              << std::setw(12) << "Median"
+              << std::setw(12) << "p5"
+              << std::setw(12) << "p95"
+              << std::setw(12) << "p99"
+              << std::setw(12) << "Stdev"
+              << std::setw(12) << "MAD"
+              << std::setw(11) << "CI"
+              << std::setw(11) << "ns/elem"
+              << std::setw(10) << "cyc/elem" << "\n";
+    std::cout << std::string(148, '-') << "\n";
+
+    for (const auto& res : results) {
+        for (const auto& timing : res.timings) {
+            const SampleStats& st = timing.stats;
+            std::stringstream samples, ci;
+            samples << st.samples.size() - st.outliers << "/" << st.samples.size();
+            ci << "+-" << std::fixed << std::setprecision(1) << 100.0 * st.relative_ci() << "%";
+            std::cout << std::left << std::setw(10) << res.array_size
+                      << std::setw(18) << timing.algorithm
+                      << std::setw(10) << samples.str()
+                      << std::setw(7) << res.batch_size
+                      << std::setw(12) << format_time(st.median)
+                      << std::setw(12) << format_time(st.p5)
+                      << std::setw(12) << format_time(st.p95)
+                      << std::setw(12) << format_time(st.p99)
+                      << std::setw(12) << format_time(st.stdev)
+                      << std::setw(12) << format_time(st.mad)
+                      << std::setw(11) << ci.str()
+                      << std::setw(11) << per_element(ns_per_sort(st.median), res.array_size)
+                      << std::setw(10) << per_element(cycles_per_sort(res, st.median), res.array_size) << "\n";
+        }
+    }
+    std::cout << std::string(148, '=') << "\n";
+
+    const std::string& status = results.front().counters_status;
+    if (status.empty()) return;
+    if (!results.front().counters_available) {
+        std::cout << "\nHARDWARE COUNTERS: unavailable (" << status << ")\n";
+        return;
+    }
+
+    std::cout << "\nHARDWARE COUNTERS (per element; " << status << "):\n";
+    std::cout << std::string(122, '-') << "\n";
+    std::cout << std::left << std::setw(10) << "Size"
+              << std::setw(18) << "Algorithm"
+              << std::setw(12) << "Cycles"
+              << std::setw(14) << "Instructions"
+              << std::setw(8) << "IPC"
+              << std::setw(12) << "L1D miss"
+              << std::setw(12) << "LLC miss"
+              << std::setw(12) << "Branch miss"
+              << std::setw(12) << "dTLB miss" << "\n";
+    std::cout << std::string(122, '-') << "\n";
+
+    for (const auto& res : results) {
+        for (const auto& timing : res.timings) {
+            const CounterValues& c = timing.counters;
+            std::stringstream ipc;
+            if (c.ipc() < 0) ipc << "N/A";
+            else ipc << std::fixed << std::setprecision(2) << c.ipc();
+            std::cout << std::left << std::setw(10) << res.array_size
+                      << std::setw(18) << timing.algorithm
+                      << std::setw(12) << per_element(c.cycles, res.array_size)
+                      << std::setw(14) << per_element(c.instructions, res.array_size)
+                      << std::setw(8) << ipc.str()
+                      << std::setw(12) << per_element(c.l1d_misses, res.array_size)
+                      << std::setw(12) << per_element(c.llc_misses, res.array_size)
+                      << std::setw(12) << per_element(c.branch_misses, res.array_size)
+                      << std::setw(12) << per_element(c.dtlb_misses, res.array_size) << "\n";
+        }
+    }
+    std::cout << std::string(122, '=') << "\n";
+}
+
+void Benchmark::print_payload_results(const std::vector<PayloadResult>& results) {
+    std::cout << std::string(92, '=') << "\n";
+    std::cout << "HEAVY ELEMENTS (average time; copies/moves on one input)\n";
+    std::cout << std::string(92, '=') << "\n";
+    std::cout << std::left << std::setw(18) << "Element"
+              << std::setw(8) << "Size"
+              << std::setw(14) << "Insertion"
+              << std::setw(14) << "Heap Sort"
+              << std::setw(14) << "std::sort"
+              << std::setw(12) << "Copies"
+              << std::setw(12) << "Moves" << "\n";
+    std::cout << std::string(92, '-') << "\n";
+
+    for (const auto& res : results) {
+        std::string insertion = res.insertion_sort_time >= 0 ?
+            format_time(res.insertion_sort_time) : "skipped";
+        std::cout << std::left << std::setw(18) << res.element_type
+                  << std::setw(8) << res.array_size
+                  << std::setw(14) << insertion
+                  << std::setw(14) << format_time(res.heap_sort_time)
+                  << std::setw(14) << format_time(res.std_sort_time)
+                  << std::setw(12) << (res.insertion_sort_copies + res.heap_sort_copies)
+                  << std::setw(12) << (res.insertion_sort_moves + res.heap_sort_moves) << "\n";
+    }
+    std::cout << std::string(92, '-') << "\n";
+    std::cout << "Copies/Moves: insertion_sort + heap_sort. Each copy of a std::string\n"
+              << "is a heap allocation; moves only transfer the buffer.\n";
+    std::cout << std::string(92, '=') << "\n";
+}
+
+void Benchmark::print_small_array_results(const std::vector<SmallArrayResult>& results) {
+    std::cout << std::string(85, '=') << "\n";
+    std::cout << "SMALL ARRAYS (average time per array, ns; SIMD: "
+              << simd::isa_name(simd::active_isa()) << ")\n";
+    std::cout << std::string(85, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Size"
+              << std::setw(15) << "Insertion"
+              << std::setw(15) << "small_sort"
+              << std::setw(15) << "std::sort"
+              << std::setw(15) << "SIMD block"
+              << std::setw(15) << "Insertion/small" << "\n";
+    std::cout << std::string(85, '-') << "\n";
+
+    for (const auto& res : results) {
+        std::stringstream ratio;
+        ratio << std::fixed << std::setprecision(2) << res.insertion_sort_ns / res.small_sort_ns << "x";
+        std::stringstream simd_block;
+        if (res.simd_block_ns >= 0) simd_block << std::fixed << std::setprecision(1) << res.simd_block_ns;
+        else simd_block << "N/A";
+        std::cout << std::left << std::fixed << std::setprecision(1)
+                  << std::setw(10) << res.array_size
+                  << std::setw(15) << res.insertion_sort_ns
+                  << std::setw(15) << res.small_sort_ns
+                  << std::setw(15) << res.std_sort_ns
+                  << std::setw(15) << simd_block.str()
+                  << std::setw(15) << ratio.str() << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+    std::cout << std::string(85, '=') << "\n";
+}
+
+void Benchmark::print_duplicates_results(const std::vector<DuplicatesResult>& results) {
+    std::cout << std::string(96, '=') << "\n";
+    std::cout << "HIGH-DUPLICATE INPUTS (average time)\n";
+    std::cout << std::string(96, '=') << "\n";
+    std::cout << std::left << std::setw(10) << "Size"
+              << std::setw(10) << "Distinct"
+              << std::setw(10) << "Strategy"
+              << std::setw(14) << "Heap Sort"
+              << std::setw(14) << "std::sort"
+              << std::setw(14) << "3-way Sort"
+              << std::setw(14) << "Card.-aware"
+              << std::setw(10) << "Heap/Card" << "\n";
+    std::cout << std::string(96, '-') << "\n";
+
+    for (const auto& res : results) {
+        std::stringstream ratio;
+        ratio << std::fixed << std::setprecision(2) << res.heap_sort_time / res.cardinality_sort_time << "x";
+        std::cout << std::left << std::setw(10) << res.array_size
+                  << std::setw(10) << res.distinct_values
+                  << std::setw(10) << res.strategy
+                  << std::setw(14) << format_time(res.heap_sort_time)
+                  << std::setw(14) << format_time(res.std_sort_time)
+                  << std::setw(14) << format_time(res.three_way_sort_time)
+                  << std::setw(14) << format_time(res.cardinality_sort_time)
+                  << std::setw(10) << ratio.str() << "\n";
+    }
+    std::cout << std::string(96, '=') << "\n";
+}
+
+void Benchmark::print_priority_queue_results(const std::vector<PriorityQueueResult>& results) {
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "PRIORITY QUEUE (million operations per second, more is better)\n";
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << std::left << std::setw(12) << "Heap size"
+              << std::setw(10) << "Workload"
+              << std::setw(14) << "std::pq"
+              << std::setw(14) << "Heap<2>"
+              << std::setw(14) << "Heap<4>"
+              << std::setw(16) << "Heap<4>/std::pq" << "\n";
+    std::cout << std::string(80, '-') << "\n";
+
+    for (const auto& res : results) {
+        std::stringstream ratio;
+        ratio << std::fixed << std::setprecision(2) << res.heap4_mops / res.std_queue_mops << "x";
+        std::cout << std::left << std::setw(12) << res.heap_size
+                  << std::setw(10) << res.workload
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << res.std_queue_mops
+                  << std::setw(14) << res.heap2_mops
+                  << std::setw(14) << res.heap4_mops
+                  << std::setw(16) << ratio.str() << "\n";
+    }
+    std::cout << std::string(80, '=') << "\n";
+}
+
+void Benchmark::print_kway_merge_results(const std::vector<KwayMergeResult>& results) {
+    std::cout << std::string(90, '=') << "\n";
+    std::cout << "K-WAY MERGE (per output element)\n";
+    std::cout << std::string(90, '=') << "\n";
+    std::cout << std::left << std::setw(8) << "Runs"
+              << std::setw(12) << "Run length"
+              << std::setw(14) << "Loser tree"
+              << std::setw(14) << "Heap"
+              << std::setw(14) << "Loser cmp"
+              << std::setw(14) << "Heap cmp"
+              << std::setw(14) << "Heap/Loser" << "\n";
+    std::cout << std::string(90, '-') << "\n";
+
+    for (const auto& res : results) {
+        std::stringstream loser_ns, heap_ns, ratio;
+        loser_ns << std::fixed << std::setprecision(2) << res.loser_tree_ns << " ns";
+        heap_ns << std::fixed << std::setprecision(2) << res.heap_ns << " ns";
+        ratio << std::fixed << std::setprecision(2) << res.heap_ns / res.loser_tree_ns << "x";
+        std::cout << std::left << std::setw(8) << res.runs
+                  << std::setw(12) << res.run_length
+                  << std::setw(14) << loser_ns.str()
+                  << std::setw(14) << heap_ns.str()
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << res.loser_tree_comparisons
+                  << std::setw(14) << res.heap_comparisons
+                  << std::setw(14) << ratio.str() << "\n";
+    }
+    std::cout << std::string(90, '=') << "\n";
+}
+
+namespace {
+
+double n_log_n(size_t n) {
+    return n > 1 ? static_cast<double>(n) * std::log2(static_cast<double>(n)) : 1.0;
+}
+
+double n_squared(size_t n) {
+    return static_cast<double>(n) * static_cast<double>(n);
+}
+
+} // namespace
+
+void Benchmark::print_operation_count_results(const std::vector<OperationCountResult>& results) {
+    std::cout << std::string(128, '=') << "\n";
+    std::cout << "OPERATION COUNTS (one input; Moves = copies + moves, swaps counted separately)\n";
+    std::cout << std::string(128, '=') << "\n";
+    std::cout << std::left << std::setw(15) << "Data"
+              << std::setw(8) << "Size"
+              << std::setw(18) << "Algorithm"
+              << std::setw(14) << "Comparisons"
+              << std::setw(12) << "Cmp/nlogn"
+              << std::setw(12) << "Cmp/n^2"
+              << std::setw(14) << "Moves"
+              << std::setw(12) << "Mov/nlogn"
+              << std::setw(12) << "Mov/n^2"
+              << std::setw(11) << "Swaps" << "\n";
+    std::cout << std::string(128, '-') << "\n";
+
+    for (const auto& res : results) {
+        size_t moves = res.counts.copies + res.counts.moves;
+        double nlogn = n_log_n(res.array_size);
+        double n2 = n_squared(res.array_size);
+        std::cout << std::left << std::setw(15) << data_type_name(res.data_type)
+                  << std::setw(8) << res.array_size
+                  << std::setw(18) << res.algorithm
+                  << std::setw(14) << res.counts.comparisons
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << res.counts.comparisons / nlogn
+                  << std::setw(12) << res.counts.comparisons / n2
+                  << std::setw(14) << moves
+                  << std::setw(12) << moves / nlogn
+                  << std::setw(12) << moves / n2
+                  << std::setw(11) << res.counts.swaps << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+    std::cout << std::string(128, '=') << "\n";
+}
+
+void Benchmark::save_operation_counts_to_csv(const std::vector<OperationCountResult>& results,
+                                             const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: cannot create file " << filename << "\n";
+        return;
+    }
+
+    file << "DataType,Size,Algorithm,Comparisons,Copies,Moves,Swaps,"
+         << "ComparisonsPerNLogN,ComparisonsPerNSquared,MovesPerNLogN,MovesPerNSquared\n";
+    for (const auto& res : results) {
+        double moves = static_cast<double>(res.counts.copies + res.counts.moves);
+        double comparisons = static_cast<double>(res.counts.comparisons);
+        file << data_type_name(res.data_type) << ","
+             << res.array_size << ","
+             << res.algorithm << ","
+             << res.counts.comparisons << ","
+             << res.counts.copies << ","
+             << res.counts.moves << ","
+             << res.counts.swaps << ","
+             << comparisons / n_log_n(res.array_size) << ","
+             << comparisons / n_squared(res.array_size) << ","
+             << moves / n_log_n(res.array_size) << ","
+             << moves / n_squared(res.array_size) << "\n";
+    }
+    std::cout << "Operation counts saved to " << filename << "\n";
 }
 
 void Benchmark::save_to_csv(const std::vector<BenchmarkResult>& results, const std::string& filename) {
@@ -176,16 +1199,80 @@ void Benchmark::save_to_csv(const std::vector<BenchmarkResult>& results, const s
         return;
     }
 
-    file << "Size,InsertionSort(us),HeapSort(us),StdSort(us),Iterations\n";
+    file << "Size,InsertionSort(us),HeapSort(us),StdSort(us),Iterations,"
+         << "HeapSortComparisons,BottomUpHeapSortComparisons,BinaryInsertionSort(us),HybridSort(us),SimdSort(us),"
+         << "HeapBuild(us),HeapExtract(us),ParallelHeapBuild(us),RadixSort(us),"
+         << "AdaptiveSort(us),NaturalRuns\n";
     for (const auto& res : results) {
         file << res.array_size << "," 
              << res.insertion_sort_time << "," 
              << res.heap_sort_time << "," 
              << res.std_sort_time << "," 
-             << res.iterations << "\n";
+             << res.iterations << ","
+             << res.heap_sort_comparisons << ","
+             << res.bottom_up_heap_sort_comparisons << ","
+             << res.binary_insertion_sort_time << ","
+             << res.hybrid_sort_time << ","
+             << res.simd_sort_time << ","
+             << res.heap_build_time << ","
+             << res.heap_extract_time << ","
+             << res.parallel_heap_build_time << ","
+             << res.radix_sort_time << ","
+             << res.adaptive_sort_time << ","
+             << res.natural_runs << "\n";
     }
     file.close();
     std::cout << "Results saved to " << filename << "\n";
+
+    // Длинный формат: строка на (размер, алгоритм), сырые замеры через ';'
+    std::string stats_filename = filename;
+    size_t dot = stats_filename.rfind('.');
+    stats_filename.insert(dot == std::string::npos ? stats_filename.size() : dot, "_stats");
+    std::ofstream stats_file(stats_filename);
+    if (!stats_file.is_open()) {
+        std::cerr << "Error: cannot create file " << stats_filename << "\n";
+        return;
+    }
+
+    stats_file << "Size,Algorithm,WarmupRuns,InputPool,Batch,Samples,Outliers,Mean(us),Median(us),P5(us),P95(us),P99(us),"
+               << "Stdev(us),MAD(us),CILow(us),CIHigh(us),NsPerElement,TscCyclesPerElement,Cycles,Instructions,IPC,"
+               << "L1DMisses,LLCMisses,"
+               << "BranchMisses,DTLBMisses,RawSamples(us)\n";
+    for (const auto& res : results) {
+        for (const auto& timing : res.timings) {
+            const SampleStats& st = timing.stats;
+            stats_file << res.array_size << ","
+                       << timing.algorithm << ","
+                       << res.warmup_runs << ","
+                       << res.input_pool << ","
+                       << res.batch_size << ","
+                       << st.samples.size() << ","
+                       << st.outliers << ","
+                       << st.mean << ","
+                       << st.median << ","
+                       << st.p5 << ","
+                       << st.p95 << ","
+                       << st.p99 << ","
+                       << st.stdev << ","
+                       << st.mad << ","
+                       << st.ci_low << ","
+                       << st.ci_high << ","
+                       << per_element_value(ns_per_sort(st.median), res.array_size) << ","
+                       << per_element_value(cycles_per_sort(res, st.median), res.array_size) << ","
+                       << timing.counters.cycles << ","
+                       << timing.counters.instructions << ","
+                       << timing.counters.ipc() << ","
+                       << timing.counters.l1d_misses << ","
+                       << timing.counters.llc_misses << ","
+                       << timing.counters.branch_misses << ","
+                       << timing.counters.dtlb_misses << ",";
+            for (size_t i = 0; i < st.samples.size(); ++i) {
+                stats_file << (i ? ";" : "") << st.samples[i];
+            }
+            stats_file << "\n";
+        }
+    }
+    std::cout << "Timing statistics saved to " << stats_filename << "\n";
 }
 
-} // namespace coursework
\ No newline at end of file
+} // namespace coursework
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "cycle_clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(COURSEWORK_SIMD_X86) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+namespace coursework {
+namespace cycle_clock {
+
+namespace {
+
+bool detect() {
+#if defined(COURSEWORK_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0x80000000);
+    if (static_cast<unsigned>(info[0]) < 0x80000007u) return false;
+    __cpuid(info, 0x80000007);
+    return (info[3] & (1 << 8)) != 0;
+#elif defined(COURSEWORK_SIMD_X86)
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+double calibrate() {
+    if (!available()) return -1.0;
+    using clock = std::chrono::steady_clock;
+    // Несколько коротких окон, берется медианное: вытеснение потока в одном
+    // окне не портит результат
+    double rates[5];
+    for (double& rate : rates) {
+        auto start = clock::now();
+        std::uint64_t ticks_start = now();
+        auto end = start;
+        while (end - start < std::chrono::milliseconds(10)) end = clock::now();
+        std::uint64_t ticks_end = now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        rate = static_cast<double>(ticks_end - ticks_start) / ns;
+    }
+    std::sort(rates, rates + 5);
+    return rates[2];
+}
+
+} // namespace
+
+bool available() {
+    static const bool invariant = detect();
+    return invariant;
+}
+
+double ticks_per_ns() {
+    static const double rate = calibrate();
+    return rate;
+}
+
+} // namespace cycle_clock
+} // namespace coursework
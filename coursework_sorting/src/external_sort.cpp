@@ -0,0 +1,325 @@
+#include "external_sort.hpp"
+#include "algorithms.hpp"
+#include "merge.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace coursework {
+
+namespace {
+
+// Файл без буферизации stdio: читаем и пишем сами крупными блоками,
+// чтобы не копировать данные дважды
+std::FILE* open_file(const std::string& path, const char* mode) {
+    std::FILE* file = std::fopen(path.c_str(), mode);
+    if (!file) throw std::runtime_error("Cannot open file " + path);
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    return file;
+}
+
+// Последовательное чтение int32 блоками по buffer_elements
+class RunReader {
+public:
+    RunReader(const std::string& path, std::size_t buffer_elements)
+        : path_(path), file_(open_file(path, "rb")), buffer_(std::max<std::size_t>(buffer_elements, 1)) {
+        refill();
+    }
+    ~RunReader() { std::fclose(file_); }
+
+    RunReader(const RunReader&) = delete;
+    RunReader& operator=(const RunReader&) = delete;
+
+    bool done() const { return pos_ == size_; }
+    const int& current() const { return buffer_[pos_]; }
+
+    void advance() {
+        if (++pos_ == size_) refill();
+    }
+
+private:
+    void refill() {
+        size_ = std::fread(buffer_.data(), sizeof(int), buffer_.size(), file_);
+        pos_ = 0;
+        if (size_ < buffer_.size() && std::ferror(file_)) throw std::runtime_error("Cannot read file " + path_);
+    }
+
+    std::string path_;
+    std::FILE* file_;
+    std::vector<int> buffer_;
+    std::size_t pos_ = 0;
+    std::size_t size_ = 0;
+};
+
+// Однопроходный итератор по RunReader для kway_merge; сравнение имеет
+// смысл только с концом (итератор без reader)
+class ReaderIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    ReaderIterator() = default;
+    explicit ReaderIterator(RunReader* reader) : reader_(reader) {}
+
+    const int& operator*() const { return reader_->current(); }
+    ReaderIterator& operator++() {
+        reader_->advance();
+        return *this;
+    }
+    bool operator==(const ReaderIterator& other) const { return at_end() == other.at_end(); }
+    bool operator!=(const ReaderIterator& other) const { return !(*this == other); }
+
+private:
+    bool at_end() const { return !reader_ || reader_->done(); }
+
+    RunReader* reader_ = nullptr;
+};
+
+// Последовательная запись int32 блоками по buffer_elements
+class RunWriter {
+public:
+    RunWriter(const std::string& path, std::size_t buffer_elements)
+        : path_(path), file_(open_file(path, "wb")) {
+        buffer_.reserve(std::max<std::size_t>(buffer_elements, 1));
+    }
+    ~RunWriter() {
+        if (file_) std::fclose(file_);
+    }
+
+    RunWriter(const RunWriter&) = delete;
+    RunWriter& operator=(const RunWriter&) = delete;
+
+    void write(int value) {
+        buffer_.push_back(value);
+        if (buffer_.size() == buffer_.capacity()) flush();
+    }
+
+    void close() {
+        flush();
+        if (std::fclose(file_) != 0) throw std::runtime_error("Cannot write file " + path_);
+        file_ = nullptr;
+    }
+
+private:
+    void flush() {
+        if (std::fwrite(buffer_.data(), sizeof(int), buffer_.size(), file_) != buffer_.size())
+            throw std::runtime_error("Cannot write file " + path_);
+        buffer_.clear();
+    }
+
+    std::string path_;
+    std::FILE* file_;
+    std::vector<int> buffer_;
+};
+
+// Выходной итератор для kway_merge: *out = x пишет x в RunWriter
+class WriterIterator {
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    explicit WriterIterator(RunWriter& writer) : writer_(&writer) {}
+
+    WriterIterator& operator*() { return *this; }
+    WriterIterator& operator++() { return *this; }
+    WriterIterator& operator=(int value) {
+        writer_->write(value);
+        return *this;
+    }
+
+private:
+    RunWriter* writer_;
+};
+
+// Временные файлы серий: уникальный префикс на вызов external_sort
+class TempFiles {
+public:
+    explicit TempFiles(const std::string& dir) {
+        static std::atomic<unsigned> counter{0};
+        std::filesystem::path base = dir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(dir);
+        auto stamp = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        prefix_ = (base / ("coursework_run_" + std::to_string(stamp) + "_" + std::to_string(counter++))).string();
+    }
+    ~TempFiles() {
+        for (const auto& path : created_) {
+            std::error_code ignored;
+            std::filesystem::remove(path, ignored);
+        }
+    }
+
+    std::string next() {
+        created_.push_back(prefix_ + "_" + std::to_string(created_.size()) + ".bin");
+        return created_.back();
+    }
+
+    static void remove(const std::string& path) {
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+    }
+
+private:
+    std::string prefix_;
+    std::vector<std::string> created_;
+};
+
+// Фаза 1, выбор с замещением. Массив heap: [0, size) - 4-арная min-куча
+// текущей серии, [size, capacity) - элементы следующей. Вершина уходит
+// в серию, следующий элемент входа занимает ее место, если он не меньше
+// записанного; иначе куча сжимается на один элемент, а он кладется
+// в освободившуюся ячейку. Когда куча пуста, следующая серия занимает
+// весь массив. На случайном входе серия в среднем вдвое длиннее массива.
+std::vector<std::string> generate_runs(const std::string& input, std::size_t capacity,
+                                       std::size_t buffer_elements, TempFiles& temp, ExternalSortStats& stats) {
+    RunReader reader(input, buffer_elements);
+    std::vector<int> heap;
+    heap.reserve(capacity);
+    while (heap.size() < capacity && !reader.done()) {
+        heap.push_back(reader.current());
+        reader.advance();
+    }
+
+    std::vector<std::string> runs;
+    if (heap.empty()) return runs;
+
+    using Distance = std::ptrdiff_t;
+    auto later = detail::make_less(std::greater<>{}, identity{});
+    Distance size = static_cast<Distance>(heap.size());
+    detail::build_heap_dary<4>(heap.begin(), heap.end(), later);
+    runs.push_back(temp.next());
+    auto writer = std::make_unique<RunWriter>(runs.back(), buffer_elements);
+
+    while (!reader.done()) {
+        int value = heap[0];
+        writer->write(value);
+        ++stats.elements;
+
+        int next = reader.current();
+        reader.advance();
+        if (next >= value) {
+            detail::sift_down_dary<4>(heap.begin(), size, Distance(0), next, later);
+            continue;
+        }
+        --size;
+        int last = heap[size];
+        heap[size] = next;
+        if (size > 0) {
+            detail::sift_down_dary<4>(heap.begin(), size, Distance(0), last, later);
+            continue;
+        }
+        writer->close();
+        runs.push_back(temp.next());
+        writer = std::make_unique<RunWriter>(runs.back(), buffer_elements);
+        size = static_cast<Distance>(heap.size());
+        detail::build_heap_dary<4>(heap.begin(), heap.end(), later);
+    }
+
+    // Вход кончился: остаток текущей серии и накопленная следующая
+    hybrid_sort(heap.begin(), heap.begin() + size);
+    for (Distance i = 0; i < size; ++i) writer->write(heap[i]);
+    writer->close();
+    if (size < static_cast<Distance>(heap.size())) {
+        hybrid_sort(heap.begin() + size, heap.end());
+        runs.push_back(temp.next());
+        writer = std::make_unique<RunWriter>(runs.back(), buffer_elements);
+        for (auto it = heap.begin() + size; it != heap.end(); ++it) writer->write(*it);
+        writer->close();
+    }
+    stats.elements += heap.size();
+    return runs;
+}
+
+// Слияние серий paths в output одним вызовом kway_merge
+void merge_files(const std::vector<std::string>& paths, const std::string& output, std::size_t buffer_elements) {
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<std::pair<ReaderIterator, ReaderIterator>> ranges;
+    for (const auto& path : paths) {
+        readers.push_back(std::make_unique<RunReader>(path, buffer_elements));
+        ranges.push_back({ReaderIterator(readers.back().get()), ReaderIterator()});
+    }
+    RunWriter writer(output, buffer_elements);
+    kway_merge(ranges, WriterIterator(writer));
+    writer.close();
+}
+
+} // namespace
+
+ExternalSortStats external_sort(const std::string& input, const std::string& output,
+                                const ExternalSortOptions& options) {
+    if (options.io_buffer_size < sizeof(int) || options.memory_budget < 3 * options.io_buffer_size) {
+        throw std::runtime_error("Memory budget must hold at least three I/O buffers");
+    }
+    ExternalSortStats stats;
+    TempFiles temp(options.temp_dir);
+    const std::size_t buffer_elements = options.io_buffer_size / sizeof(int);
+    stats.fan_in = std::max<std::size_t>(2, options.memory_budget / options.io_buffer_size - 1);
+
+    // Фаза 1: буферы входа и текущей серии, остальное - куча
+    auto start = std::chrono::high_resolution_clock::now();
+    stats.heap_elements = (options.memory_budget - 2 * options.io_buffer_size) / sizeof(int);
+    std::vector<std::string> runs = generate_runs(input, stats.heap_elements, buffer_elements, temp, stats);
+    stats.bytes = stats.elements * sizeof(int);
+    stats.runs = runs.size();
+    auto generated = std::chrono::high_resolution_clock::now();
+    stats.run_generation_seconds = std::chrono::duration<double>(generated - start).count();
+
+    // Фаза 2: проходы по fan_in серий, пока все не сольются за один
+    while (runs.size() > stats.fan_in) {
+        std::vector<std::string> merged;
+        for (std::size_t first = 0; first < runs.size(); first += stats.fan_in) {
+            std::size_t last = std::min(runs.size(), first + stats.fan_in);
+            if (last - first == 1) {
+                merged.push_back(runs[first]);
+                continue;
+            }
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + last);
+            merged.push_back(temp.next());
+            merge_files(group, merged.back(), buffer_elements);
+            for (const auto& path : group) TempFiles::remove(path);
+        }
+        runs = std::move(merged);
+        ++stats.merge_passes;
+    }
+    merge_files(runs, output, buffer_elements);
+    ++stats.merge_passes;
+    stats.merge_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - generated).count();
+    return stats;
+}
+
+void write_random_file(const std::string& path, std::uint64_t count) {
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+    RunWriter writer(path, std::size_t(1) << 20);
+    for (std::uint64_t i = 0; i < count; ++i) writer.write(dist(rng));
+    writer.close();
+}
+
+bool is_sorted_file(const std::string& path) {
+    RunReader reader(path, std::size_t(1) << 20);
+    if (reader.done()) return true;
+    int previous = reader.current();
+    for (reader.advance(); !reader.done(); reader.advance()) {
+        if (reader.current() < previous) return false;
+        previous = reader.current();
+    }
+    return true;
+}
+
+} // namespace coursework
@@ -2,6 +2,8 @@
 #include <random>
 #include <algorithm>
 #include <chrono>  // для получения сида
+#include <string>
+#include <iterator>
 
 namespace coursework {
 
@@ -33,4 +35,44 @@ std::vector<int> ArrayGenerator::generate(size_t size, DataType type) {
     return data;
 }
 
-} // namespace coursework
\ No newline at end of file
+std::vector<std::string> ArrayGenerator::generate_strings(size_t size, DataType type) {
+    std::vector<int> keys = generate(size, type);
+    std::vector<std::string> data;
+    data.reserve(size);
+    for (int key : keys) {
+        // Ключ со сдвигом и нулями слева, чтобы порядок строк совпадал с порядком чисел
+        std::string digits = std::to_string(static_cast<long long>(key) + 1000000000LL);
+        data.push_back("record-key-" + std::string(24 - digits.size(), '0') + digits);
+    }
+    return data;
+}
+
+std::vector<int> ArrayGenerator::generate_few_unique(size_t size, int distinct) {
+    std::vector<int> data(size);
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<int> dist(-(distinct / 2), distinct - distinct / 2 - 1);
+    for (auto& x : data) x = dist(rng);
+    return data;
+}
+
+std::vector<Record> ArrayGenerator::generate_records(size_t size, DataType type) {
+    std::vector<int> keys = generate(size, type);
+    std::vector<Record> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i].key = keys[i];
+        std::fill(std::begin(data[i].payload), std::end(data[i].payload), static_cast<char>(i));
+    }
+    return data;
+}
+
+InputPool::InputPool(ArrayGenerator& generator, size_t size, DataType type, size_t count, size_t max_bytes)
+    : size_(size), count_(std::max<size_t>(count, 1)) {
+    if (size > 0) count_ = std::max<size_t>(1, std::min(count_, max_bytes / (size * sizeof(int))));
+    arena_.reserve(size_ * count_);
+    for (size_t i = 0; i < count_; ++i) {
+        std::vector<int> data = generator.generate(size, type);
+        arena_.insert(arena_.end(), data.begin(), data.end());
+    }
+}
+
+} // namespace coursework
\ No newline at end of file
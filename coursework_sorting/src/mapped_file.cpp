@@ -0,0 +1,97 @@
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace coursework {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what, const std::string& path) {
+    throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+const char* advice_name(MapAdvice advice) {
+    switch (advice) {
+        case MapAdvice::NORMAL: return "normal";
+        case MapAdvice::SEQUENTIAL: return "sequential";
+        case MapAdvice::RANDOM: return "random";
+        case MapAdvice::WILLNEED: return "willneed";
+        default: return "none";
+    }
+}
+
+MappedFile::MappedFile(const std::string& path) : path_(path) {
+    fd_ = ::open(path.c_str(), O_RDWR);
+    if (fd_ < 0) throw_errno("Cannot open", path);
+
+    struct stat info;
+    if (::fstat(fd_, &info) != 0) {
+        ::close(fd_);
+        throw_errno("Cannot stat", path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    // Пустой файл отобразить нельзя: data() == nullptr, size() == 0
+    if (size_ == 0) return;
+
+    data_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        ::close(fd_);
+        throw_errno("Cannot map", path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_) ::munmap(data_, size_);
+    if (fd_ >= 0) ::close(fd_);
+}
+
+void MappedFile::advise(MapAdvice advice) {
+    if (!data_ || advice == MapAdvice::NONE) return;
+    int flag = MADV_NORMAL;
+    switch (advice) {
+        case MapAdvice::SEQUENTIAL: flag = MADV_SEQUENTIAL; break;
+        case MapAdvice::RANDOM: flag = MADV_RANDOM; break;
+        case MapAdvice::WILLNEED: flag = MADV_WILLNEED; break;
+        default: break;
+    }
+    if (::madvise(data_, size_, flag) != 0) throw_errno("Cannot madvise", path_);
+}
+
+void MappedFile::sync() {
+    if (data_ && ::msync(data_, size_, MS_SYNC) != 0) throw_errno("Cannot msync", path_);
+}
+
+PageFaults page_faults() {
+    struct rusage usage;
+    PageFaults faults;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+        faults.minor = usage.ru_minflt;
+        faults.major = usage.ru_majflt;
+    }
+    return faults;
+}
+
+void evict_from_page_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw_errno("Cannot open", path);
+    ::fdatasync(fd);
+    int error = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+    if (error != 0) {
+        errno = error;
+        throw_errno("Cannot evict", path);
+    }
+}
+
+} // namespace coursework
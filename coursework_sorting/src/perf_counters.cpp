@@ -0,0 +1,175 @@
+#include "perf_counters.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace coursework {
+
+namespace {
+
+// Поля CounterValues в порядке fds_
+double CounterValues::* const counter_fields[] = {
+    &CounterValues::cycles,
+    &CounterValues::instructions,
+    &CounterValues::l1d_misses,
+    &CounterValues::llc_misses,
+    &CounterValues::branch_misses,
+    &CounterValues::dtlb_misses,
+};
+
+const char* const counter_names[] = {
+    "cycles", "instructions", "L1D misses", "LLC misses", "branch misses", "dTLB misses",
+};
+
+} // namespace
+
+double CounterValues::ipc() const {
+    if (cycles <= 0.0 || instructions < 0.0) return -1.0;
+    return instructions / cycles;
+}
+
+CounterValues& CounterValues::operator+=(const CounterValues& other) {
+    for (auto field : counter_fields) {
+        if (this->*field < 0.0 || other.*field < 0.0) this->*field = -1.0;
+        else this->*field += other.*field;
+    }
+    return *this;
+}
+
+CounterValues CounterValues::operator-(const CounterValues& other) const {
+    CounterValues result = *this;
+    for (auto field : counter_fields) {
+        if (result.*field < 0.0 || other.*field < 0.0) result.*field = -1.0;
+        else result.*field -= other.*field;
+    }
+    return result;
+}
+
+CounterValues CounterValues::scaled(double factor) const {
+    CounterValues result = *this;
+    for (auto field : counter_fields) {
+        if (result.*field >= 0.0) result.*field *= factor;
+    }
+    return result;
+}
+
+#ifdef __linux__
+
+namespace {
+
+constexpr std::uint64_t cache_event(std::uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+struct EventConfig {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+const EventConfig counter_events[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_DTLB)},
+};
+
+int open_event(const EventConfig& event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters(bool enabled) {
+    if (!enabled) {
+        status_ = "disabled";
+        return;
+    }
+    std::string opened;
+    int first_error = 0;
+    for (int i = 0; i < counter_count; ++i) {
+        fds_[i] = open_event(counter_events[i]);
+        if (fds_[i] >= 0) {
+            opened += (opened.empty() ? "" : ", ") + std::string(counter_names[i]);
+        } else if (first_error == 0) {
+            first_error = errno;
+        }
+    }
+    available_ = !opened.empty();
+    status_ = available_ ? opened
+                         : std::string("perf_event_open failed: ") + std::strerror(first_error);
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    for (int fd : fds_) {
+        if (fd < 0) continue;
+        ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+CounterValues PerfCounters::read() const {
+    CounterValues values;
+    for (int i = 0; i < counter_count; ++i) {
+        if (fds_[i] < 0) continue;
+        // value, time_enabled, time_running
+        std::uint64_t data[3] = {0, 0, 0};
+        if (::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        double value = static_cast<double>(data[0]);
+        if (data[2] > 0 && data[2] < data[1]) {
+            value *= static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        }
+        // Счетчик ни разу не попал на PMU - значение неизвестно
+        values.*counter_fields[i] = data[1] > 0 && data[2] == 0 ? -1.0 : value;
+    }
+    return values;
+}
+
+CounterValues PerfCounters::stop() {
+    for (int fd : fds_) {
+        if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    return read();
+}
+
+#else
+
+PerfCounters::PerfCounters(bool enabled) {
+    status_ = enabled ? "perf_event_open is available only on Linux" : "disabled";
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+CounterValues PerfCounters::read() const { return {}; }
+
+CounterValues PerfCounters::stop() { return {}; }
+
+#endif
+
+} // namespace coursework
@@ -0,0 +1,163 @@
+#include "simd_sort.hpp"
+#include "algorithms.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#if defined(COURSEWORK_SIMD_X86) && defined(_MSC_VER)
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+namespace coursework {
+namespace simd {
+
+#if defined(COURSEWORK_SIMD_X86)
+// Ядра из simd_sort_avx2.cpp / simd_sort_avx512.cpp
+namespace avx2 {
+void sort_block(int* data, std::size_t n);
+void sort_block(float* data, std::size_t n);
+void merge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out);
+void merge(const float* a, std::size_t na, const float* b, std::size_t nb, float* out);
+} // namespace avx2
+
+namespace avx512 {
+void sort_block(int* data, std::size_t n);
+void sort_block(float* data, std::size_t n);
+void merge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out);
+void merge(const float* a, std::size_t na, const float* b, std::size_t nb, float* out);
+} // namespace avx512
+#endif
+
+namespace {
+
+Isa detect() {
+#if defined(COURSEWORK_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+    if (__builtin_cpu_supports("avx2")) return Isa::AVX2;
+#elif defined(COURSEWORK_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (osxsave && max_leaf >= 7) {
+        // ОС должна сохранять YMM (биты 1-2) и ZMM/маски (биты 5-7) в XCR0
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+        bool avx512f = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+        if (avx512f) return Isa::AVX512;
+        if (avx2) return Isa::AVX2;
+    }
+#endif
+    return Isa::SCALAR;
+}
+
+Isa& active() {
+    static Isa isa = detected_isa();
+    return isa;
+}
+
+// Скалярный путь: сеть/вставки для блока, слияние std::merge
+template<typename T>
+void sort_block_scalar(T* data, std::size_t n) {
+    if (n <= detail::max_network_size) {
+        std::less<> less;
+        sort_with_network(data, n, less);
+    } else {
+        insertion_sort(data, data + n);
+    }
+}
+
+template<typename T>
+void sort_block_dispatch(T* data, std::size_t n) {
+    switch (active_isa()) {
+#if defined(COURSEWORK_SIMD_X86)
+        case Isa::AVX512: avx512::sort_block(data, n); return;
+        case Isa::AVX2: avx2::sort_block(data, n); return;
+#endif
+        default: sort_block_scalar(data, n); return;
+    }
+}
+
+template<typename T>
+void merge_dispatch(const T* a, std::size_t na, const T* b, std::size_t nb, T* out) {
+    switch (active_isa()) {
+#if defined(COURSEWORK_SIMD_X86)
+        case Isa::AVX512: avx512::merge(a, na, b, nb, out); return;
+        case Isa::AVX2: avx2::merge(a, na, b, nb, out); return;
+#endif
+        default: std::merge(a, a + na, b, b + nb, out); return;
+    }
+}
+
+// Блоки по max_block_size сортируются в регистрах, затем проходы слияния
+// с удвоением ширины, попеременно из data в буфер и обратно
+template<typename T>
+void simd_sort_impl(T* first, T* last) {
+    std::size_t n = static_cast<std::size_t>(last - first);
+    if (n <= 1) return;
+    if (n <= max_block_size) {
+        sort_block_dispatch(first, n);
+        return;
+    }
+
+    for (std::size_t i = 0; i < n; i += max_block_size) {
+        sort_block_dispatch(first + i, std::min(max_block_size, n - i));
+    }
+
+    std::vector<T> buffer(n);
+    T* from = first;
+    T* to = buffer.data();
+    for (std::size_t width = max_block_size; width < n; width *= 2) {
+        for (std::size_t i = 0; i < n; i += 2 * width) {
+            std::size_t mid = std::min(i + width, n);
+            std::size_t end = std::min(i + 2 * width, n);
+            merge_dispatch(from + i, mid - i, from + mid, end - mid, to + i);
+        }
+        std::swap(from, to);
+    }
+    if (from != first) std::memcpy(first, from, n * sizeof(T));
+}
+
+} // namespace
+
+Isa detected_isa() {
+    static const Isa isa = detect();
+    return isa;
+}
+
+Isa active_isa() {
+    return active();
+}
+
+void set_active_isa(Isa isa) {
+    active() = static_cast<int>(isa) <= static_cast<int>(detected_isa()) ? isa : detected_isa();
+}
+
+const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX512: return "AVX-512";
+        case Isa::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+void sort_block(int* data, std::size_t n) { sort_block_dispatch(data, n); }
+void sort_block(float* data, std::size_t n) { sort_block_dispatch(data, n); }
+
+void merge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    merge_dispatch(a, na, b, nb, out);
+}
+
+void merge(const float* a, std::size_t na, const float* b, std::size_t nb, float* out) {
+    merge_dispatch(a, na, b, nb, out);
+}
+
+void simd_sort(int* first, int* last) { simd_sort_impl(first, last); }
+void simd_sort(float* first, float* last) { simd_sort_impl(first, last); }
+
+} // namespace simd
+} // namespace coursework
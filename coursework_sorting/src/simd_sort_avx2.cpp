@@ -0,0 +1,72 @@
+// simd_sort_avx2.cpp - собирается с -mavx2 (/arch:AVX2), вызывается
+// только после проверки CPUID в simd_sort.cpp
+#include <immintrin.h>
+#include <cmath>
+#include <climits>
+#include "simd_sort_impl.hpp"
+
+namespace {
+
+struct Avx2Int {
+    using T = int;
+    using V = __m256i;
+    static constexpr int L = 8;
+
+    static T max_value() { return INT_MAX; }
+    static V load(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(T* p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static V min(V a, V b) { return _mm256_min_epi32(a, b); }
+    static V max(V a, V b) { return _mm256_max_epi32(a, b); }
+    static V permute(V v, int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7) {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7));
+    }
+    template<int Mask>
+    static V blend(V lo, V hi) { return _mm256_blend_epi32(lo, hi, Mask); }
+};
+
+struct Avx2Float {
+    using T = float;
+    using V = __m256;
+    static constexpr int L = 8;
+
+    static T max_value() { return HUGE_VALF; }
+    static V load(const T* p) { return _mm256_loadu_ps(p); }
+    static void store(T* p, V v) { _mm256_storeu_ps(p, v); }
+    // _mm256_min_ps/_mm256_max_ps на паре -0.0/+0.0 возвращают один и тот же
+    // операнд, и знак нуля теряется. Сравнение по целочисленному ключу
+    // (отрицательные числа с инвертированными битами величины) упорядочивает
+    // -0.0 < +0.0, поэтому min и max всегда дают перестановку пары
+    static __m256i key(V v) {
+        __m256i bits = _mm256_castps_si256(v);
+        return _mm256_xor_si256(bits, _mm256_srli_epi32(_mm256_srai_epi32(bits, 31), 1));
+    }
+    static V greater(V a, V b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(key(a), key(b))); }
+    static V min(V a, V b) { return _mm256_blendv_ps(a, b, greater(a, b)); }
+    static V max(V a, V b) { return _mm256_blendv_ps(b, a, greater(a, b)); }
+    static V permute(V v, int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7) {
+        return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7));
+    }
+    template<int Mask>
+    static V blend(V lo, V hi) { return _mm256_blend_ps(lo, hi, Mask); }
+};
+
+} // namespace
+
+namespace coursework {
+namespace simd {
+namespace avx2 {
+
+void sort_block(int* data, std::size_t n) { ::sort_block<Avx2Int>(data, n); }
+void sort_block(float* data, std::size_t n) { ::sort_block<Avx2Float>(data, n); }
+
+void merge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    merge_arrays<Avx2Int>(a, na, b, nb, out);
+}
+
+void merge(const float* a, std::size_t na, const float* b, std::size_t nb, float* out) {
+    merge_arrays<Avx2Float>(a, na, b, nb, out);
+}
+
+} // namespace avx2
+} // namespace simd
+} // namespace coursework
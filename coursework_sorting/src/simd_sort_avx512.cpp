@@ -0,0 +1,77 @@
+// simd_sort_avx512.cpp - собирается с -mavx512f (/arch:AVX512), вызывается
+// только после проверки CPUID в simd_sort.cpp
+#if defined(__GNUC__) && !defined(__clang__)
+    // Ложное срабатывание GCC 12 на _mm512_undefined_epi32() внутри интринсиков
+    #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#include <cmath>
+#include <climits>
+#include "simd_sort_impl.hpp"
+
+namespace {
+
+struct Avx512Int {
+    using T = int;
+    using V = __m512i;
+    static constexpr int L = 16;
+
+    static T max_value() { return INT_MAX; }
+    static V load(const T* p) { return _mm512_loadu_si512(p); }
+    static void store(T* p, V v) { _mm512_storeu_si512(p, v); }
+    static V min(V a, V b) { return _mm512_min_epi32(a, b); }
+    static V max(V a, V b) { return _mm512_max_epi32(a, b); }
+    static V permute(V v, int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7,
+                     int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15) {
+        return _mm512_permutexvar_epi32(
+            _mm512_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15), v);
+    }
+    template<int Mask>
+    static V blend(V lo, V hi) { return _mm512_mask_blend_epi32(static_cast<__mmask16>(Mask), lo, hi); }
+};
+
+struct Avx512Float {
+    using T = float;
+    using V = __m512;
+    static constexpr int L = 16;
+
+    static T max_value() { return HUGE_VALF; }
+    static V load(const T* p) { return _mm512_loadu_ps(p); }
+    static void store(T* p, V v) { _mm512_storeu_ps(p, v); }
+    // Как в Avx2Float: сравнение по целочисленному ключу, -0.0 < +0.0
+    static __m512i key(V v) {
+        __m512i bits = _mm512_castps_si512(v);
+        return _mm512_xor_si512(bits, _mm512_srli_epi32(_mm512_srai_epi32(bits, 31), 1));
+    }
+    static __mmask16 greater(V a, V b) { return _mm512_cmpgt_epi32_mask(key(a), key(b)); }
+    static V min(V a, V b) { return _mm512_mask_blend_ps(greater(a, b), a, b); }
+    static V max(V a, V b) { return _mm512_mask_blend_ps(greater(a, b), b, a); }
+    static V permute(V v, int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7,
+                     int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15) {
+        return _mm512_permutexvar_ps(
+            _mm512_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15), v);
+    }
+    template<int Mask>
+    static V blend(V lo, V hi) { return _mm512_mask_blend_ps(static_cast<__mmask16>(Mask), lo, hi); }
+};
+
+} // namespace
+
+namespace coursework {
+namespace simd {
+namespace avx512 {
+
+void sort_block(int* data, std::size_t n) { ::sort_block<Avx512Int>(data, n); }
+void sort_block(float* data, std::size_t n) { ::sort_block<Avx512Float>(data, n); }
+
+void merge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    merge_arrays<Avx512Int>(a, na, b, nb, out);
+}
+
+void merge(const float* a, std::size_t na, const float* b, std::size_t nb, float* out) {
+    merge_arrays<Avx512Float>(a, na, b, nb, out);
+}
+
+} // namespace avx512
+} // namespace simd
+} // namespace coursework
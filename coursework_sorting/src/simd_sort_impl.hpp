@@ -0,0 +1,199 @@
+// simd_sort_impl.hpp
+//
+// Обобщенные битонические ядра для simd_sort_avx2.cpp и simd_sort_avx512.cpp.
+// Подключается только в эти файлы (каждый собирается со своими флагами
+// -mavx2 / -mavx512f), все определения - в безымянном пространстве имен,
+// чтобы код с AVX-инструкциями не попал в общие inline-функции программы.
+// По той же причине здесь не используются шаблоны стандартной библиотеки.
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// Перестановка "партнер на расстоянии D": lane ^ D
+constexpr int xor_lane(int lane, int d) { return lane ^ d; }
+
+// Разворот второй половины каждой группы из 2M элементов
+constexpr int reverse_run_lane(int lane, int m) { return (lane & m) ? (lane ^ (m - 1)) : lane; }
+
+// Маска дорожек, получающих максимум в полуочистителе на расстоянии D
+template<int L, int D>
+constexpr int high_lane_mask() {
+    int mask = 0;
+    for (int lane = 0; lane < L; ++lane)
+        if (lane & D) mask |= 1 << lane;
+    return mask;
+}
+
+// X - набор примитивов конкретного ISA: V, T, L, load/store/min/max,
+// permute(v, idx...) и blend<Mask>(lo, hi) (бит маски - брать из hi)
+template<class X, int D, std::size_t... I>
+inline typename X::V permute_xor(typename X::V v, std::index_sequence<I...>) {
+    return X::permute(v, xor_lane(static_cast<int>(I), D)...);
+}
+
+template<class X, int M, std::size_t... I>
+inline typename X::V permute_reverse_run(typename X::V v, std::index_sequence<I...>) {
+    return X::permute(v, reverse_run_lane(static_cast<int>(I), M)...);
+}
+
+template<class X, std::size_t... I>
+inline typename X::V permute_reverse(typename X::V v, std::index_sequence<I...>) {
+    return X::permute(v, (X::L - 1 - static_cast<int>(I))...);
+}
+
+// Полуочистители на расстояниях D, D/2, ..., 1 внутри регистра
+template<class X, int D>
+inline typename X::V clean_down(typename X::V v) {
+    typename X::V p = permute_xor<X, D>(v, std::make_index_sequence<X::L>{});
+    v = X::template blend<high_lane_mask<X::L, D>()>(X::min(v, p), X::max(v, p));
+    if constexpr (D > 1) v = clean_down<X, D / 2>(v);
+    return v;
+}
+
+// Сортировка регистра: слияние отсортированных отрезков длины M в 2M
+template<class X, int M = 1>
+inline typename X::V sort_register(typename X::V v) {
+    if constexpr (M < X::L) {
+        if constexpr (M > 1) v = permute_reverse_run<X, M>(v, std::make_index_sequence<X::L>{});
+        v = clean_down<X, M>(v);
+        return sort_register<X, 2 * M>(v);
+    } else {
+        return v;
+    }
+}
+
+template<class X>
+inline typename X::V reverse_register(typename X::V v) {
+    return permute_reverse<X>(v, std::make_index_sequence<X::L>{});
+}
+
+// Слияние двух отсортированных регистров: a - младшие L, b - старшие L
+template<class X>
+inline void merge_registers(typename X::V& a, typename X::V& b) {
+    typename X::V rb = reverse_register<X>(b);
+    typename X::V lo = X::min(a, rb);
+    typename X::V hi = X::max(a, rb);
+    a = clean_down<X, X::L / 2>(lo);
+    b = clean_down<X, X::L / 2>(hi);
+}
+
+// Count отсортированных регистров -> одна отсортированная последовательность
+template<class X, int Count>
+inline void merge_register_runs(typename X::V* r) {
+    for (int run = 1; run < Count; run *= 2) {
+        for (int g = 0; g < Count; g += 2 * run) {
+            // Разворот второго отрезка: обратный порядок регистров и дорожек
+            for (int i = 0; i < run / 2; ++i) {
+                typename X::V t = r[g + run + i];
+                r[g + run + i] = r[g + 2 * run - 1 - i];
+                r[g + 2 * run - 1 - i] = t;
+            }
+            for (int i = 0; i < run; ++i) r[g + run + i] = reverse_register<X>(r[g + run + i]);
+
+            // Полуочистители между регистрами, затем внутри каждого регистра
+            for (int dist = run; dist >= 1; dist /= 2) {
+                for (int i = g; i < g + 2 * run; i += 2 * dist) {
+                    for (int k = 0; k < dist; ++k) {
+                        typename X::V lo = X::min(r[i + k], r[i + k + dist]);
+                        typename X::V hi = X::max(r[i + k], r[i + k + dist]);
+                        r[i + k] = lo;
+                        r[i + k + dist] = hi;
+                    }
+                }
+            }
+            for (int i = g; i < g + 2 * run; ++i) r[i] = clean_down<X, X::L / 2>(r[i]);
+        }
+    }
+}
+
+template<class X, int Count>
+inline void sort_registers(typename X::T* buffer) {
+    typename X::V r[Count];
+    for (int i = 0; i < Count; ++i) r[i] = sort_register<X>(X::load(buffer + i * X::L));
+    merge_register_runs<X, Count>(r);
+    for (int i = 0; i < Count; ++i) X::store(buffer + i * X::L, r[i]);
+}
+
+// n <= 64: копия в буфер, дополненный максимальным значением до размера
+// ближайшего блока (L, 2L, 4L, 8L), сортировка в регистрах и обратно
+template<class X>
+void sort_block(typename X::T* data, std::size_t n) {
+    using T = typename X::T;
+    alignas(64) T buffer[64];
+    std::size_t regs = 1;
+    while (regs * X::L < n) regs *= 2;
+    std::memcpy(buffer, data, n * sizeof(T));
+    for (std::size_t i = n; i < regs * X::L; ++i) buffer[i] = X::max_value();
+
+    switch (regs) {
+        case 1: sort_registers<X, 1>(buffer); break;
+        case 2: sort_registers<X, 2>(buffer); break;
+        case 4: sort_registers<X, 4>(buffer); break;
+        case 8:
+            // 8 регистров нужны только при L = 8; для L = 16 блок не больше 4
+            if constexpr (8 * X::L <= 64) sort_registers<X, 8>(buffer);
+            break;
+        default: break;
+    }
+    std::memcpy(data, buffer, n * sizeof(T));
+}
+
+// Слияние трех отсортированных последовательностей (хвосты векторного слияния)
+template<class T>
+void merge3_scalar(const T* a, std::size_t na, const T* b, std::size_t nb,
+                   const T* c, std::size_t nc, T* out) {
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na || j < nb || k < nc) {
+        int pick = -1;
+        if (i < na) pick = 0;
+        if (j < nb && (pick < 0 || b[j] < a[i])) pick = 1;
+        if (k < nc && (pick < 0 || c[k] < (pick == 0 ? a[i] : b[j]))) pick = 2;
+        if (pick == 0) *out++ = a[i++];
+        else if (pick == 1) *out++ = b[j++];
+        else *out++ = c[k++];
+    }
+}
+
+// Векторное слияние: в регистре hi держатся L наибольших из просмотренных,
+// следующий блок берется из массива с меньшим очередным элементом
+template<class X>
+void merge_arrays(const typename X::T* a, std::size_t na,
+                  const typename X::T* b, std::size_t nb, typename X::T* out) {
+    using T = typename X::T;
+    const std::size_t L = X::L;
+    if (na < L || nb < L) {
+        merge3_scalar<T>(a, na, b, nb, nullptr, 0, out);
+        return;
+    }
+
+    typename X::V lo = X::load(a);
+    typename X::V hi = X::load(b);
+    std::size_t ia = L, ib = L;
+    for (;;) {
+        merge_registers<X>(lo, hi);
+        X::store(out, lo);
+        out += L;
+        lo = hi;
+
+        bool take_a = ia < na && (ib >= nb || !(b[ib] < a[ia]));
+        if (take_a) {
+            if (na - ia < L) break;
+            hi = X::load(a + ia);
+            ia += L;
+        } else {
+            if (ib >= nb || nb - ib < L) break;
+            hi = X::load(b + ib);
+            ib += L;
+        }
+    }
+
+    alignas(64) T tail[64];
+    X::store(tail, lo);
+    merge3_scalar<T>(tail, L, a + ia, na - ia, b + ib, nb - ib, out);
+}
+
+} // namespace
@@ -0,0 +1,95 @@
+#include "statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace coursework {
+
+namespace {
+
+// Медиана неотсортированной выборки; порядок элементов портится
+double median_inplace(std::vector<double>& values) {
+    std::size_t half = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + half, values.end());
+    double upper = values[half];
+    if (values.size() % 2 != 0) return upper;
+    return (*std::max_element(values.begin(), values.begin() + half) + upper) / 2.0;
+}
+
+} // namespace
+
+double SampleStats::relative_ci() const {
+    if (median <= 0.0) return 0.0;
+    return (ci_high - ci_low) / 2.0 / median;
+}
+
+double quantile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return -1.0;
+    double position = q * static_cast<double>(sorted.size() - 1);
+    std::size_t lower = static_cast<std::size_t>(position);
+    if (lower + 1 >= sorted.size()) return sorted.back();
+    double fraction = position - static_cast<double>(lower);
+    return sorted[lower] + fraction * (sorted[lower + 1] - sorted[lower]);
+}
+
+SampleStats summarize(std::vector<double> samples, bool reject_outliers, std::size_t resamples) {
+    SampleStats stats;
+    stats.samples = std::move(samples);
+    if (stats.samples.empty()) return stats;
+
+    std::vector<double> kept = stats.samples;
+    std::sort(kept.begin(), kept.end());
+    std::vector<double> deviations(kept.size());
+
+    auto compute_mad = [&](double center) {
+        for (std::size_t i = 0; i < kept.size(); ++i) deviations[i] = std::abs(kept[i] - center);
+        return median_inplace(deviations);
+    };
+
+    if (reject_outliers) {
+        double center = quantile(kept, 0.5);
+        double limit = 3.5 * 1.4826 * compute_mad(center);
+        // MAD == 0 (больше половины замеров совпали) - границы нет
+        if (limit > 0.0) {
+            kept.erase(std::remove_if(kept.begin(), kept.end(),
+                                      [&](double x) { return std::abs(x - center) > limit; }),
+                       kept.end());
+            deviations.resize(kept.size());
+        }
+    }
+    stats.outliers = stats.samples.size() - kept.size();
+
+    std::size_t n = kept.size();
+    stats.mean = std::accumulate(kept.begin(), kept.end(), 0.0) / static_cast<double>(n);
+    stats.median = quantile(kept, 0.5);
+    stats.p5 = quantile(kept, 0.05);
+    stats.p95 = quantile(kept, 0.95);
+    stats.p99 = quantile(kept, 0.99);
+    double squares = 0.0;
+    for (double x : kept) squares += (x - stats.mean) * (x - stats.mean);
+    stats.stdev = n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0.0;
+    stats.mad = compute_mad(stats.median);
+
+    // Bootstrap: медианы повторных выборок с возвращением, ДИ - их
+    // 2.5% и 97.5% квантили
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    std::vector<double> medians(resamples);
+    std::vector<double> resample(n);
+    for (auto& m : medians) {
+        for (auto& x : resample) x = kept[pick(rng)];
+        m = median_inplace(resample);
+    }
+    if (medians.empty()) {
+        stats.ci_low = stats.ci_high = stats.median;
+    } else {
+        std::sort(medians.begin(), medians.end());
+        stats.ci_low = quantile(medians, 0.025);
+        stats.ci_high = quantile(medians, 0.975);
+    }
+    return stats;
+}
+
+} // namespace coursework
@@ -54,9 +54,19 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     std::vector<double> insertion_times;
     std::vector<double> heap_times;
     std::vector<double> std_times;
+    std::vector<double> radix_times;
     
     std::string line;
-    std::getline(csv, line); // Пропускаем заголовок
+    std::getline(csv, line); // Заголовок: ищем необязательную колонку RadixSort(us)
+    int radix_column = -1;
+    {
+        std::stringstream header(line);
+        std::string name;
+        for (int column = 0; std::getline(header, name, ','); ++column) {
+            if (!name.empty() && name.back() == '\r') name.pop_back();
+            if (name == "RadixSort(us)") radix_column = column;
+        }
+    }
     
     while (std::getline(csv, line)) {
         std::stringstream ss(line);
@@ -73,6 +83,8 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
                 insertion_times.push_back(std::stod(tokens[1]));
                 heap_times.push_back(std::stod(tokens[2]));
                 std_times.push_back(std::stod(tokens[3]));
+                radix_times.push_back(radix_column >= 0 && static_cast<size_t>(radix_column) < tokens.size() ?
+                                      std::stod(tokens[radix_column]) : -1.0);
             } catch (...) {
                 // Пропускаем некорректные строки
             }
@@ -94,6 +106,13 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
             break;
         }
     }
+    bool has_radix_data = false;
+    for (double t : radix_times) {
+        if (t > 0) {
+            has_radix_data = true;
+            break;
+        }
+    }
     
     // Создаем SVG файл
     std::ofstream svg(output_svg);
@@ -107,6 +126,7 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     colors.insertion = "#FF4444";  // Красный
     colors.heap = "#4444FF";       // Синий
     colors.stdsort = "#44AA44";    // Зеленый
+    colors.radix = "#AA44AA";      // Фиолетовый
     colors.grid = "#E0E0E0";       // Серый
     colors.axis = "#000000";       // Черный
     colors.text = "#333333";       // Темно-серый
@@ -148,6 +168,11 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     svg << "    <stop offset=\"100%\" stop-color=\"" << colors.stdsort << "\" stop-opacity=\"0.1\"/>\n";
     svg << "  </linearGradient>\n";
     
+    svg << "  <linearGradient id=\"radixGradient\" x1=\"0%\" y1=\"0%\" x2=\"100%\" y2=\"0%\">\n";
+    svg << "    <stop offset=\"0%\" stop-color=\"" << colors.radix << "\" stop-opacity=\"0.3\"/>\n";
+    svg << "    <stop offset=\"100%\" stop-color=\"" << colors.radix << "\" stop-opacity=\"0.1\"/>\n";
+    svg << "  </linearGradient>\n";
+    
     svg << "</defs>\n\n";
     
     // ==================== ФОН ====================
@@ -211,6 +236,9 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     }
     max_time = std::max(max_time, get_max_value(heap_times));
     max_time = std::max(max_time, get_max_value(std_times));
+    if (has_radix_data) {
+        max_time = std::max(max_time, get_max_value(radix_times));
+    }
     
     if (max_time <= 0) max_time = 1.0;
     
@@ -297,8 +325,11 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     
     // Рисуем графики (в обратном порядке для правильного наложения)
     
-    // 1. std::sort (фон)
+    // 1. std::sort и Radix Sort (фон)
     draw_graph_with_area(std_times, colors.stdsort, "stdGradient", "std");
+    if (has_radix_data) {
+        draw_graph_with_area(radix_times, colors.radix, "radixGradient", "radix");
+    }
     
     // 2. Heap Sort
     draw_graph_with_area(heap_times, colors.heap, "heapGradient", "heap");
@@ -316,11 +347,8 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     svg << "<rect x=\"" << (legend_x - 10) << "\" y=\"" << (legend_y - 10) << "\" "
         << "width=\"190\" height=\"";
     
-    if (has_insertion_data) {
-        svg << (legend_item_height * 3 + 10);
-    } else {
-        svg << (legend_item_height * 2 + 10);
-    }
+    int legend_items = 2 + (has_insertion_data ? 1 : 0) + (has_radix_data ? 1 : 0);
+    svg << (legend_item_height * legend_items + 10);
     
     svg << "\" fill=\"white\" stroke=\"" << colors.grid << "\" stroke-width=\"1\" "
         << "rx=\"5\" ry=\"5\"/>\n";
@@ -363,6 +391,19 @@ bool SvgPlotter::create_performance_svg(const std::string& csv_filename,
     svg << "<text x=\"" << (legend_x + 40) << "\" y=\"" << current_y << "\" "
         << "class=\"legend-text\" fill=\"" << colors.text << "\">std::sort</text>\n";
     
+    if (has_radix_data) {
+        current_y += legend_item_height;
+        
+        // Radix Sort
+        svg << "<line x1=\"" << legend_x << "\" y1=\"" << (current_y - 5) << "\" "
+            << "x2=\"" << (legend_x + 30) << "\" y2=\"" << (current_y - 5) << "\" "
+            << "stroke=\"" << colors.radix << "\" stroke-width=\"3\"/>\n";
+        svg << "<circle cx=\"" << (legend_x + 15) << "\" cy=\"" << (current_y - 5) << "\" "
+            << "r=\"4\" fill=\"" << colors.radix << "\"/>\n";
+        svg << "<text x=\"" << (legend_x + 40) << "\" y=\"" << current_y << "\" "
+            << "class=\"legend-text\" fill=\"" << colors.text << "\">Radix Sort</text>\n";
+    }
+    
     // ==================== ИНФОРМАЦИЯ О ДАННЫХ ====================
     svg << "<text x=\"" << MARGIN << "\" y=\"30\" "
         << "class=\"tick-label\" fill=\"" << colors.text << "\">\n";
@@ -666,4 +707,4 @@ bool SvgPlotter::create_all_svg_plots(const std::string& csv_filename) {
     return false;
 }
 
-} // namespace coursework
\ No newline at end of file
+} // namespace coursework
\ No newline at end of file
@@ -1,27 +1,374 @@
 #include "algorithms.hpp"
+#include "parallel_sort.hpp"
+#include "heap.hpp"
+#include "merge.hpp"
+#include "external_sort.hpp"
+#include "statistics.hpp"
+#include "perf_counters.hpp"
+#include "op_counter.hpp"
+#include "generators.hpp"
+#include "cycle_clock.hpp"
 #include <iostream>
+#include <atomic>
+#include <stdexcept>
 #include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <cstdlib>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// Сортирует копию test указанным алгоритмом и проверяет результат
+template<typename Sort>
+bool check(const char* name, const std::vector<int>& test, Sort sort) {
+    std::vector<int> copy = test;
+    sort(copy.begin(), copy.end());
+    bool ok = std::is_sorted(copy.begin(), copy.end());
+    if (!ok) std::cout << "✗ " << name << " failed\n";
+    return ok;
+}
+
+// Тип без копирования: сортировки обязаны только перемещать элементы
+struct MoveOnly {
+    std::unique_ptr<int> value;
+
+    bool operator>(const MoveOnly& other) const { return *value > *other.value; }
+    bool operator<(const MoveOnly& other) const { return *value < *other.value; }
+};
+
+template<typename Sort>
+bool check_move_only(const char* name, const std::vector<int>& test, Sort sort) {
+    std::vector<MoveOnly> items;
+    for (int x : test) items.push_back(MoveOnly{std::unique_ptr<int>(new int(x))});
+    sort(items.begin(), items.end());
+    bool ok = std::is_sorted(items.begin(), items.end());
+    if (!ok) std::cout << "✗ " << name << " (move-only) failed\n";
+    return ok;
+}
 
 int main() {
     std::cout << "Quick correctness test...\n";
     
     // Тест 1
     std::vector<int> test1 = {5, 2, 4, 6, 1, 3};
-    std::vector<int> copy1 = test1;
-    std::vector<int> copy2 = test1;
-    
-    coursework::insertion_sort(copy1.begin(), copy1.end());
-    coursework::heap_sort(copy2.begin(), copy2.end());
-    
-    bool ok1 = std::is_sorted(copy1.begin(), copy1.end());
-    bool ok2 = std::is_sorted(copy2.begin(), copy2.end());
+    // Тест 2: неполные группы детей в d-арной куче и повторы
+    std::vector<int> test2 = {9, -3, 7, 7, 0, 12, -8, 5, 5, 1, 30, -2, 4};
+    // Тест 3: обратный порядок (длинные сдвиги в binary_insertion_sort)
+    std::vector<int> test3(40);
+    for (int i = 0; i < 40; ++i) test3[i] = 40 - i;
+
+    using It = std::vector<int>::iterator;
+    bool ok = true;
+    for (const auto& test : {test1, test2, test3}) {
+        ok &= check("insertion_sort", test, [](It b, It e) { coursework::insertion_sort(b, e); });
+        ok &= check("binary_insertion_sort", test, [](It b, It e) { coursework::binary_insertion_sort(b, e); });
+        ok &= check("heap_sort", test, [](It b, It e) { coursework::heap_sort(b, e); });
+        ok &= check("bottom_up_heap_sort", test, [](It b, It e) { coursework::bottom_up_heap_sort(b, e); });
+        ok &= check("heap_sort<4>", test, [](It b, It e) { coursework::heap_sort<4>(b, e); });
+        ok &= check("heap_sort<8>", test, [](It b, It e) { coursework::heap_sort<8>(b, e); });
+        ok &= check("prefetch_heap_sort", test, [](It b, It e) { coursework::prefetch_heap_sort(b, e); });
+        ok &= check("hybrid_sort", test, [](It b, It e) { coursework::hybrid_sort(b, e); });
+        ok &= check("small_sort", test, [](It b, It e) { coursework::small_sort(b, e); });
+        ok &= check("simd_sort", test, [](It b, It e) { coursework::simd::simd_sort(&*b, &*b + (e - b)); });
+        ok &= check("radix_sort", test, [](It b, It e) { coursework::radix_sort(b, e); });
+        ok &= check("three_way_sort", test, [](It b, It e) { coursework::three_way_sort(b, e); });
+        ok &= check("counting_sort", test, [](It b, It e) { coursework::counting_sort(b, e); });
+        ok &= check("adaptive_sort", test, [](It b, It e) { coursework::adaptive_sort(b, e); });
+    }
+
+    // Hybrid Sort на отрезках длиннее порога вставок: повторы, разбиение
+    std::vector<int> big(5000);
+    for (int i = 0; i < 5000; ++i) big[i] = (i * 7919) % 1013 - 500;
+    ok &= check("hybrid_sort (5000)", big, [](It b, It e) { coursework::hybrid_sort(b, e); });
+    // Hybrid Sort с малым порогом: все перестановки 3-5 элементов
+    // (при n = 3 медиана трех не должна оставлять отрезок без сторожа)
+    for (int n = 3; n <= 5; ++n) {
+        std::vector<std::string> perm;
+        for (int i = 0; i < n; ++i) perm.push_back(std::to_string(i * 4 + 1));
+        std::sort(perm.begin(), perm.end());
+        do {
+            std::vector<std::string> a = perm, b = perm;
+            coursework::hybrid_sort<2>(a.begin(), a.end());
+            coursework::hybrid_sort<3>(b.begin(), b.end());
+            ok &= std::is_sorted(a.begin(), a.end()) && std::is_sorted(b.begin(), b.end());
+        } while (std::next_permutation(perm.begin(), perm.end()));
+    }
+    ok &= check("radix_sort (5000)", big, [](It b, It e) { coursework::radix_sort(b, e); });
+    ok &= check("radix_sort<11> (5000)", big, [](It b, It e) { coursework::radix_sort<11>(b, e); });
+    ok &= check("radix_sort<16> (5000)", big, [](It b, It e) { coursework::radix_sort<16>(b, e); });
+    ok &= check("three_way_sort (5000)", big, [](It b, It e) { coursework::three_way_sort(b, e); });
+    ok &= check("cardinality_aware_sort (5000)", big, [](It b, It e) { coursework::cardinality_aware_sort(b, e); });
+    ok &= check("adaptive_sort (5000)", big, [](It b, It e) { coursework::adaptive_sort(b, e); });
+
+    // Adaptive Sort: устойчивость (пары с равными ключами) и число серий
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < 5000; ++i) pairs.push_back({big[i] % 7, i});
+    coursework::adaptive_sort(pairs.begin(), pairs.end(), std::less<>{},
+                              [](const std::pair<int, int>& p) { return p.first; });
+    ok &= std::is_sorted(pairs.begin(), pairs.end());
+    ok &= coursework::count_runs(test3.begin(), test3.end()) == 1;
+
+    // Выбор стратегии: узкий диапазон целых - подсчет, повторы строк - 3-way
+    std::vector<int> dup(100000);
+    for (int i = 0; i < 100000; ++i) dup[i] = (i * 7919) % 2001 - 1000;
+    ok &= coursework::choose_sort_strategy(dup.begin(), dup.end()) == coursework::SortStrategy::COUNTING;
+    ok &= check("cardinality_aware_sort (counting)", dup, [](It b, It e) { coursework::cardinality_aware_sort(b, e); });
+    std::vector<std::string> dup_strings;
+    for (int x : dup) dup_strings.push_back(std::to_string(x % 16));
+    ok &= coursework::choose_sort_strategy(dup_strings.begin(), dup_strings.end()) == coursework::SortStrategy::THREE_WAY;
+    coursework::cardinality_aware_sort(dup_strings.begin(), dup_strings.end());
+    ok &= std::is_sorted(dup_strings.begin(), dup_strings.end());
+
+    // SIMD Sort на каждом наборе инструкций: неполные блоки, слияния, +-inf
+    std::vector<float> floats(1000);
+    for (int i = 0; i < 1000; ++i) floats[i] = static_cast<float>((i * 7919) % 1013) * 0.5f - 250.0f;
+    floats[10] = HUGE_VALF;
+    floats[500] = -HUGE_VALF;
+    for (auto isa : {coursework::simd::Isa::SCALAR, coursework::simd::Isa::AVX2, coursework::simd::Isa::AVX512}) {
+        coursework::simd::set_active_isa(isa);
+        for (std::size_t n : {std::size_t(17), std::size_t(64), std::size_t(100), big.size()}) {
+            std::vector<int> part(big.begin(), big.begin() + static_cast<std::ptrdiff_t>(n));
+            ok &= check("simd_sort", part, [](It b, It e) { coursework::simd::simd_sort(&*b, &*b + (e - b)); });
+            ok &= check("hybrid_sort", part, [](It b, It e) { coursework::hybrid_sort(b, e); });
+        }
+        std::vector<float> f = floats;
+        coursework::simd::simd_sort(f.data(), f.data() + f.size());
+        ok &= std::is_sorted(f.begin(), f.end());
+        f = floats;
+        coursework::radix_sort(f.begin(), f.end());
+        ok &= std::is_sorted(f.begin(), f.end());
+
+        // -0.0 и +0.0 равны по <, но векторные min/max не должны терять знак:
+        // число отрицательных нулей после сортировки то же
+        for (std::size_t n : {std::size_t(20), std::size_t(64), std::size_t(10000)}) {
+            std::vector<float> zeros(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                std::size_t r = (i * 7919) % 13;
+                zeros[i] = r < 5 ? -0.0f : r < 9 ? 0.0f : static_cast<float>(r) - 11.0f;
+            }
+            auto negative_zeros = [](const std::vector<float>& v) {
+                return std::count_if(v.begin(), v.end(), [](float x) { return x == 0.0f && std::signbit(x); });
+            };
+            auto expected = negative_zeros(zeros);
+            std::vector<float> z1 = zeros, z2 = zeros, z3 = zeros;
+            coursework::hybrid_sort(z1.begin(), z1.end());
+            coursework::simd::simd_sort(z2.data(), z2.data() + z2.size());
+            if (n <= coursework::simd::max_block_size) coursework::small_sort(z3.begin(), z3.end());
+            else z3 = z1;
+            for (const auto& z : {z1, z2, z3})
+                ok &= std::is_sorted(z.begin(), z.end()) && negative_zeros(z) == expected;
+        }
+    }
+    coursework::simd::set_active_isa(coursework::simd::detected_isa());
+
+    // Parallel Sort: выше порога параллельного режима, повторы и убывание
+    coursework::ThreadPool pool(4);
+    // Исключение задачи доходит до вызывающего, пул остается рабочим
+    for (std::size_t thrower : {std::size_t(0), std::size_t(63)}) {
+        std::atomic<std::size_t> done{0};
+        bool caught = false;
+        try {
+            pool.parallel_for(64, [&](std::size_t i) {
+                if (i == thrower) throw std::runtime_error("task failed");
+                ++done;
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        ok &= caught && done < 64;
+    }
+    std::atomic<std::size_t> completed{0};
+    pool.parallel_for(64, [&](std::size_t) { ++completed; });
+    ok &= completed == 64;
+    std::vector<int> large(200000);
+    for (int i = 0; i < 200000; ++i) large[i] = (i * 7919) % 100003 - 50000;
+    ok &= check("parallel_sort", large, [&pool](It b, It e) { coursework::parallel_sort(pool, b, e); });
+    std::vector<int> large_desc = large;
+    coursework::parallel_sort(pool, large_desc.begin(), large_desc.end(), std::greater<>{});
+    ok &= std::is_sorted(large_desc.begin(), large_desc.end(), std::greater<>{});
+    std::vector<std::string> strings;
+    for (int x : large) strings.push_back(std::to_string(x));
+    coursework::parallel_sort(pool, strings.begin(), strings.end());
+    ok &= std::is_sorted(strings.begin(), strings.end()) && strings.size() == large.size();
+
+    // Параллельное построение кучи дает ту же кучу, что build_heap
+    std::vector<int> heap1 = large, heap2 = large;
+    coursework::build_heap(heap1.begin(), heap1.end());
+    coursework::parallel_build_heap(pool, heap2.begin(), heap2.end());
+    ok &= std::is_heap(heap2.begin(), heap2.end()) && heap1 == heap2;
+    ok &= check("heap_sort (pool)", large, [&pool](It b, It e) { coursework::heap_sort(pool, b, e); });
+    ok &= check("parallel_radix_sort", large, [&pool](It b, It e) { coursework::parallel_radix_sort(pool, b, e); });
+    for (const auto& test : {test1, test2, test3}) {
+        ok &= check("heap_sort (pool)", test, [&pool](It b, It e) { coursework::heap_sort(pool, b, e); });
+    }
+
+    // Порядок по убыванию и сортировка по ключу через проекцию
+    std::vector<int> desc = test2;
+    coursework::heap_sort(desc.begin(), desc.end(), std::greater<>{});
+    ok &= std::is_sorted(desc.begin(), desc.end(), std::greater<>{});
+    coursework::insertion_sort(desc.begin(), desc.end(), std::less<>{}, [](int x) { return x < 0 ? -x : x; });
+    ok &= std::is_sorted(desc.begin(), desc.end(), [](int a, int b) { return std::abs(a) < std::abs(b); });
+    // small_sort с пользовательским компаратором не переставляет -3 и 3
+    auto by_abs = [](int a, int b) { return std::abs(a) < std::abs(b); };
+    std::vector<int> signs = {3, -3, -1, 2, 1, -2, 0, 3, -1};
+    std::vector<int> signs_stable = signs;
+    std::stable_sort(signs_stable.begin(), signs_stable.end(), by_abs);
+    coursework::small_sort(signs.begin(), signs.end(), by_abs);
+    ok &= signs == signs_stable;
+
+    // Heap: извлечение в порядке убывания, pop_push и смена приоритета по handle
+    coursework::Heap<int> queue(large.begin(), large.end());
+    std::vector<int> popped;
+    while (!queue.empty()) {
+        popped.push_back(queue.top());
+        queue.pop();
+    }
+    ok &= std::is_sorted(popped.begin(), popped.end(), std::greater<>{}) && popped.size() == large.size();
+
+    coursework::Heap<int, std::greater<>, 2> min_queue;
+    std::vector<coursework::Heap<int, std::greater<>, 2>::Handle> handles;
+    for (int x : test2) handles.push_back(min_queue.push_handle(x));
+    min_queue.decrease_key(handles.back(), -100);
+    ok &= min_queue.top() == -100 && min_queue.value(handles.back()) == -100;
+    min_queue.update(handles.back(), 100);
+    ok &= min_queue.pop_push(50) == *std::min_element(test2.begin(), test2.end() - 1);
+    ok &= !min_queue.contains(handles.front()) || min_queue.value(handles.front()) == test2.front();
+
+    // Top-k: partial_heap_sort и TopK против std::partial_sort
+    for (std::size_t k : {std::size_t(0), std::size_t(1), std::size_t(10), std::size_t(1000), large.size()}) {
+        std::vector<int> expected = large, partial = large;
+        std::partial_sort(expected.begin(), expected.begin() + k, expected.end(), std::greater<>{});
+        coursework::partial_heap_sort(partial.begin(), partial.begin() + k, partial.end(), std::greater<>{});
+        ok &= std::equal(expected.begin(), expected.begin() + k, partial.begin());
+
+        coursework::TopK<int, std::greater<>> top(k);
+        top.consume(large.begin(), large.begin() + large.size() / 2);
+        top.consume(large.begin() + large.size() / 2, large.end());
+        std::vector<int> best = top.sorted();
+        ok &= best.size() == k && std::equal(best.begin(), best.end(), expected.begin());
+    }
+
+    // k-way merge: 7 серий разной длины (включая пустую) против std::stable_sort,
+    // равные ключи должны выходить в порядке номеров серий
+    std::vector<std::vector<std::pair<int, int>>> shards(7);
+    std::vector<std::pair<int, int>> all_pairs;
+    for (std::size_t i = 0; i < large.size() / 10; ++i) {
+        std::size_t shard = (i * 7919) % 6;
+        shards[shard].push_back({large[i] % 100, static_cast<int>(i)});
+    }
+    auto by_key = [](const std::pair<int, int>& p) { return p.first; };
+    using PairIt = std::vector<std::pair<int, int>>::const_iterator;
+    std::vector<std::pair<PairIt, PairIt>> shard_ranges;
+    for (auto& shard : shards) {
+        std::stable_sort(shard.begin(), shard.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        all_pairs.insert(all_pairs.end(), shard.begin(), shard.end());
+        shard_ranges.push_back({shard.cbegin(), shard.cend()});
+    }
+    std::stable_sort(all_pairs.begin(), all_pairs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<std::pair<int, int>> merged(all_pairs.size());
+    ok &= coursework::kway_merge(shard_ranges, merged.begin(), std::less<>{}, by_key) == merged.end();
+    ok &= merged == all_pairs;
+    std::fill(merged.begin(), merged.end(), std::pair<int, int>{});
+    ok &= coursework::heap_kway_merge(shard_ranges, merged.begin(), std::less<>{}, by_key) == merged.end();
+    ok &= merged == all_pairs;
+
+    // Внешняя сортировка: бюджет 12 KB - куча на 1024 числа, слияние по 2
+    // серии за проход, т.е. несколько проходов уже на 100000 элементах
+    {
+        auto dir = std::filesystem::temp_directory_path();
+        std::string input = (dir / "coursework_test_input.bin").string();
+        std::string output = (dir / "coursework_test_output.bin").string();
+        coursework::write_random_file(input, 100000);
+        coursework::ExternalSortOptions options;
+        options.memory_budget = 12 << 10;
+        options.io_buffer_size = 4 << 10;
+        auto stats = coursework::external_sort(input, output, options);
+        ok &= stats.elements == 100000 && stats.merge_passes > 1;
+        ok &= coursework::is_sorted_file(output) && std::filesystem::file_size(output) == 100000 * sizeof(int);
+        std::filesystem::remove(input);
+        std::filesystem::remove(output);
+    }
+
+    // Статистики замеров: квантили с интерполяцией, выброс 1000 отбрасывается
+    // и не влияет на медиану, ДИ медианы накрывает ее
+    {
+        std::vector<double> sorted_samples = {1, 2, 3, 4, 5};
+        ok &= coursework::quantile(sorted_samples, 0.5) == 3.0 && coursework::quantile(sorted_samples, 0.25) == 2.0;
+        ok &= coursework::quantile(sorted_samples, 0.1) == 1.4 && coursework::quantile(sorted_samples, 1.0) == 5.0;
+
+        std::vector<double> samples;
+        for (int i = 0; i < 50; ++i) samples.push_back(10.0 + (i % 5) * 0.1);
+        samples.push_back(1000.0);
+        auto stats = coursework::summarize(samples);
+        ok &= stats.samples.size() == 51 && stats.outliers == 1;
+        ok &= std::abs(stats.median - 10.2) < 1e-9 && std::abs(stats.mean - 10.2) < 1e-9;
+        ok &= std::abs(stats.mad - 0.1) < 1e-9 && stats.p99 < 11.0;
+        ok &= stats.ci_low <= stats.median && stats.median <= stats.ci_high && stats.relative_ci() < 0.02;
+        ok &= coursework::summarize(samples, false).outliers == 0 && coursework::summarize({}).median < 0;
+    }
+
+    // Счетчики: -1 (недоступен) не смешивается с числами, выключенные
+    // счетчики всегда дают -1
+    {
+        coursework::CounterValues a{100, 250, 10, 2, 5, 1};
+        coursework::CounterValues b = a;
+        b.l1d_misses = -1;
+        a += a;
+        ok &= a.cycles == 200 && a.instructions == 500 && a.ipc() == 2.5;
+        ok &= (a - b).cycles == 100 && (a - b).l1d_misses < 0 && a.scaled(0.5).dtlb_misses == 1;
+        coursework::PerfCounters disabled(false);
+        disabled.start();
+        ok &= !disabled.available() && disabled.stop().cycles < 0 && disabled.stop().ipc() < 0;
+    }
+
+    // Счетчики операций: insertion_sort на отсортированном входе - n-1
+    // сравнений и ни одной копии; iter_swap - обмен, а не три перемещения
+    {
+        using Counted = coursework::Counted<int>;
+        std::vector<Counted> counted;
+        for (int i = 0; i < 40; ++i) counted.emplace_back(i);
+        Counted::reset();
+        coursework::insertion_sort(counted.begin(), counted.end());
+        ok &= Counted::counts.comparisons == 39 && Counted::counts.copies == 0;
+        Counted::reset();
+        std::iter_swap(counted.begin(), counted.end() - 1);
+        ok &= Counted::counts.swaps == 1 && Counted::counts.moves == 0 && counted.front().value == 39;
+    }
+
+    // Пул входов: при нехватке max_bytes входов меньше, input(i) по кругу
+    {
+        coursework::ArrayGenerator generator;
+        coursework::InputPool pool(generator, 100, coursework::DataType::SORTED, 10, 4 * 100 * sizeof(int));
+        ok &= pool.count() == 4 && pool.size() == 100 && pool.input(5) == pool.input(1);
+        ok &= std::is_sorted(pool.input(3), pool.input(3) + 100) && pool.input(3)[99] == 99;
+    }
+
+    // TSC: не убывает, частота калибруется; без инвариантного TSC - -1
+    if (coursework::cycle_clock::available()) {
+        std::uint64_t first = coursework::cycle_clock::now();
+        ok &= coursework::cycle_clock::now() >= first && coursework::cycle_clock::ticks_per_ns() > 0.0;
+    } else {
+        ok &= coursework::cycle_clock::ticks_per_ns() < 0.0;
+    }
+
+    using MoveIt = std::vector<MoveOnly>::iterator;
+    ok &= check_move_only("insertion_sort", test3, [](MoveIt b, MoveIt e) { coursework::insertion_sort(b, e); });
+    ok &= check_move_only("binary_insertion_sort", test3, [](MoveIt b, MoveIt e) { coursework::binary_insertion_sort(b, e); });
+    ok &= check_move_only("heap_sort", test3, [](MoveIt b, MoveIt e) { coursework::heap_sort(b, e); });
+    ok &= check_move_only("bottom_up_heap_sort", test3, [](MoveIt b, MoveIt e) { coursework::bottom_up_heap_sort(b, e); });
+    ok &= check_move_only("heap_sort<4>", test3, [](MoveIt b, MoveIt e) { coursework::heap_sort<4>(b, e); });
+    ok &= check_move_only("three_way_sort", test3, [](MoveIt b, MoveIt e) { coursework::three_way_sort(b, e); });
+    ok &= check_move_only("adaptive_sort", test3, [](MoveIt b, MoveIt e) { coursework::adaptive_sort(b, e); });
     
-    if (ok1 && ok2) {
-        std::cout << "✓ Both algorithms work correctly\n";
+    if (ok) {
+        std::cout << "✓ All algorithms work correctly\n";
         return 0;
     } else {
         std::cout << "✗ Error in algorithms\n";
         return 1;
     }
-}
\ No newline at end of file
+}
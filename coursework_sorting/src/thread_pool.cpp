@@ -0,0 +1,167 @@
+#include "thread_pool.hpp"
+
+namespace coursework {
+
+namespace {
+
+// Поток выполняет задачу пула: вложенные parallel_for идут последовательно
+thread_local bool inside_pool_task = false;
+
+// Выставляет inside_pool_task на время выполнения задач и восстанавливает
+// прежнее значение, в том числе при исключении
+class PoolTaskScope {
+public:
+    PoolTaskScope() : previous_(inside_pool_task) { inside_pool_task = true; }
+    ~PoolTaskScope() { inside_pool_task = previous_; }
+
+    PoolTaskScope(const PoolTaskScope&) = delete;
+    PoolTaskScope& operator=(const PoolTaskScope&) = delete;
+
+private:
+    bool previous_;
+};
+
+std::unique_ptr<ThreadPool>& global_pool() {
+    static std::unique_ptr<ThreadPool> pool;
+    return pool;
+}
+
+std::mutex& global_pool_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    for (std::size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+    // Очередь 0 принадлежит вызывающему потоку
+    for (std::size_t i = 1; i < threads; ++i) workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t)>& f) {
+    if (count == 0) return;
+    if (size() == 1 || count == 1 || inside_pool_task) {
+        for (std::size_t i = 0; i < count; ++i) f(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        task_ = &f;
+        remaining_.store(count);
+        failed_.store(false);
+        error_ = nullptr;
+    }
+    // Раскладка по кругу: соседние задачи (обычно соседние участки
+    // массива) достаются разным потокам
+    for (std::size_t i = 0; i < count; ++i) {
+        Queue& queue = *queues_[i % size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    {
+        PoolTaskScope scope;
+        run_tasks(0);
+    }
+
+    // run_tasks не выпускает исключений, поэтому f и run_mutex_ живут,
+    // пока потоки пула не закончат свои задачи
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    done_cv_.wait(lock, [this] { return remaining_.load() == 0; });
+    task_ = nullptr;
+    std::exception_ptr error = std::move(error_);
+    error_ = nullptr;
+    lock.unlock();
+    if (error) std::rethrow_exception(error);
+}
+
+bool ThreadPool::pop(std::size_t id, std::size_t& item) {
+    {
+        Queue& own = *queues_[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.items.empty()) {
+            item = own.items.back();
+            own.items.pop_back();
+            return true;
+        }
+    }
+    // Перехват: обход чужих очередей начиная со следующей
+    for (std::size_t k = 1; k < size(); ++k) {
+        Queue& victim = *queues_[(id + k) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.items.empty()) {
+            item = victim.items.front();
+            victim.items.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run_tasks(std::size_t id) {
+    std::size_t item;
+    while (pop(id, item)) {
+        // После первого исключения оставшиеся задачи только снимаются с очереди
+        if (!failed_.load(std::memory_order_relaxed)) {
+            try {
+                (*task_)(item);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state_mutex_);
+                if (!error_) error_ = std::current_exception();
+                failed_.store(true, std::memory_order_relaxed);
+            }
+        }
+        if (remaining_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            done_cv_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::worker_loop(std::size_t id) {
+    inside_pool_task = true;
+    std::size_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        run_tasks(id);
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    std::lock_guard<std::mutex> lock(global_pool_mutex());
+    auto& pool = global_pool();
+    if (!pool) pool = std::make_unique<ThreadPool>();
+    return *pool;
+}
+
+void ThreadPool::set_global_threads(std::size_t threads) {
+    std::lock_guard<std::mutex> lock(global_pool_mutex());
+    global_pool() = std::make_unique<ThreadPool>(threads);
+}
+
+} // namespace coursework